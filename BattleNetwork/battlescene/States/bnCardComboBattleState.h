@@ -27,6 +27,7 @@ struct CardComboBattleState final : public BattleSceneState {
   PA::Steps paSteps; /*!< Matching steps in a PA */
   swoosh::Timer PAStartTimer; /*!< Time to scale the PA graphic */
   sf::Sprite programAdvanceSprite;
+  std::shared_ptr<sf::Texture> programAdvanceTexture;
   Font font;
   SelectedCardsUI& ui;
   std::shared_ptr<std::vector<Battle::Card>> cardsListPtr{ nullptr };
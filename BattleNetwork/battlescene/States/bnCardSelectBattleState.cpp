@@ -22,8 +22,10 @@ CardSelectBattleState::CardSelectBattleState() :
   cardSelectInputCooldown = maxCardSelectInputCooldown;
 
   // Load assets
-  mobBackdropSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_BACKDROP));
-  mobEdgeSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_EDGE));
+  mobBackdropTexture = Textures().LoadFromFile(TexturePaths::MOB_NAME_BACKDROP);
+  mobBackdropSprite = sf::Sprite(*mobBackdropTexture);
+  mobEdgeTexture = Textures().LoadFromFile(TexturePaths::MOB_NAME_EDGE);
+  mobEdgeSprite = sf::Sprite(*mobEdgeTexture);
 
   mobBackdropSprite.setScale(2.f, 2.f);
   mobEdgeSprite.setScale(2.f, 2.f);
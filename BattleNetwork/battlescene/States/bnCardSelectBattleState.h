@@ -32,6 +32,7 @@ class CardSelectBattleState final : public BattleSceneState {
   float streamVolume{ -1.f };
   Font font;
   sf::Sprite mobEdgeSprite, mobBackdropSprite; /*!< name backdrop images*/
+  std::shared_ptr<sf::Texture> mobEdgeTexture, mobBackdropTexture;
   std::shared_ptr<std::vector<Battle::Card>> cards; /*!< List of Card* the user selects from the card cust */
 
   // Check if a form change was properly triggered
@@ -8,7 +8,8 @@
 
 CharacterTransformBattleState::CharacterTransformBattleState()
 {
-  shine = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_BOSS_SHINE));
+  shineTexture = Textures().LoadFromFile(TexturePaths::MOB_BOSS_SHINE);
+  shine = sf::Sprite(*shineTexture);
   shine.setScale(2.f, 2.f);
 }
 
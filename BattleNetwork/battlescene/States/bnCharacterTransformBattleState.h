@@ -24,6 +24,7 @@ private:
   double frameElapsed{ 0 };
   bool skipBackdrop{ false };
   sf::Sprite shine;
+  std::shared_ptr<sf::Texture> shineTexture;
   std::vector<Animation> shineAnimations;
   const bool FadeInBackdrop();
   const bool FadeOutBackdrop();
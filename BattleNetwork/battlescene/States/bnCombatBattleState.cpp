@@ -18,7 +18,8 @@ CombatBattleState::CombatBattleState(double customDuration) :
   pauseShader(Shaders().GetShader(ShaderType::BLACK_FADE))
 {
   // PAUSE
-  pause.setTexture(*Textures().LoadFromFile("resources/ui/pause.png"));
+  pauseTexture = Textures().LoadFromFile("resources/ui/pause.png");
+  pause.setTexture(*pauseTexture);
   pause.setScale(2.f, 2.f);
   pause.setOrigin(pause.getLocalBounds().width * 0.5f, pause.getLocalBounds().height * 0.5f);
   pause.setPosition(sf::Vector2f(240.f, 145.f));
@@ -32,16 +33,19 @@ CombatBattleState::CombatBattleState(double customDuration) :
   // COMBO DELETE AND COUNTER LABELS
   auto labelPosition = sf::Vector2f(240.0f, 50.f);
 
-  doubleDelete = sf::Sprite(*Textures().LoadFromFile(TexturePaths::DOUBLE_DELETE));
+  doubleDeleteTexture = Textures().LoadFromFile(TexturePaths::DOUBLE_DELETE);
+  doubleDelete = sf::Sprite(*doubleDeleteTexture);
   doubleDelete.setOrigin(doubleDelete.getLocalBounds().width / 2.0f, doubleDelete.getLocalBounds().height / 2.0f);
   doubleDelete.setPosition(labelPosition);
   doubleDelete.setScale(2.f, 2.f);
 
   tripleDelete = doubleDelete;
-  tripleDelete.setTexture(*Textures().LoadFromFile(TexturePaths::TRIPLE_DELETE));
+  tripleDeleteTexture = Textures().LoadFromFile(TexturePaths::TRIPLE_DELETE);
+  tripleDelete.setTexture(*tripleDeleteTexture);
 
   counterHit = doubleDelete;
-  counterHit.setTexture(*Textures().LoadFromFile(TexturePaths::COUNTER_HIT));
+  counterHitTexture = Textures().LoadFromFile(TexturePaths::COUNTER_HIT);
+  counterHit.setTexture(*counterHitTexture);
 }
 
 const bool CombatBattleState::IsMobCleared() const
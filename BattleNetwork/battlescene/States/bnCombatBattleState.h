@@ -26,6 +26,7 @@ struct CombatBattleState final : public BattleSceneState, public CardActionUseLi
   sf::Sprite doubleDelete;
   sf::Sprite tripleDelete;
   sf::Sprite counterHit;
+  std::shared_ptr<sf::Texture> pauseTexture, doubleDeleteTexture, tripleDeleteTexture, counterHitTexture;
   sf::Shader* pauseShader; /*!< Dim screen */
   std::vector<const BattleSceneState*> subcombatStates;
   const bool IsMobCleared() const;
@@ -7,7 +7,7 @@
 #include "../../bnAnimatedTextBox.h"
 #include "../../bnMessage.h"
 
-RetreatBattleState::RetreatBattleState(AnimatedTextBox& textbox, const sf::Sprite& mug, const Animation& anim) : 
+RetreatBattleState::RetreatBattleState(AnimatedTextBox& textbox, const std::shared_ptr<sf::Texture>& mug, const Animation& anim) : 
   textbox(textbox),
   mug(mug),
   anim(anim) {
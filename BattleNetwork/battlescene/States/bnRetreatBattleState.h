@@ -11,7 +11,7 @@
 struct RetreatBattleState final : public BattleSceneState {
   bool escaped{};
   AnimatedTextBox& textbox;
-  sf::Sprite mug;
+  std::shared_ptr<sf::Texture> mug;
   Animation anim;
 
   enum class state : short {
@@ -20,7 +20,7 @@ struct RetreatBattleState final : public BattleSceneState {
     fail
   } currState{};
 
-  RetreatBattleState(AnimatedTextBox& textbox, const sf::Sprite& mug, const Animation& anim);
+  RetreatBattleState(AnimatedTextBox& textbox, const std::shared_ptr<sf::Texture>& mug, const Animation& anim);
 
   void onStart(const BattleSceneState*) override;
   void onUpdate(double elapsed) override;
@@ -220,7 +220,8 @@ void TimeFreezeBattleState::onUpdate(double elapsed)
 
 void TimeFreezeBattleState::onDraw(sf::RenderTexture& surface)
 {
-  static sf::Sprite alertSprite(*Textures().LoadFromFile("resources/ui/alert.png"));
+  static std::shared_ptr<sf::Texture> alertTexture = Textures().LoadFromFile("resources/ui/alert.png");
+  static sf::Sprite alertSprite(*alertTexture);
   static sf::RectangleShape bar;
 
   if (tfEvents.empty()) return;
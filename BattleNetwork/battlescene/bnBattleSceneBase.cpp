@@ -26,12 +26,71 @@
 #include "../bnFadeInState.h"
 #include "../bnRandom.h"
 
+#ifdef BN_MOD_SUPPORT
+#include <cstdio>
+#include "../bnText.h"
+#include "../bnLuaProfiler.h"
+#endif
+
 // Combos are counted if more than one enemy is hit within x frames
 // The game is clocked to display 60 frames per second
 // If x = 20 frames, then we want a combo hit threshold of 20/60 = 0.3 seconds
 #define COMBO_HIT_THRESHOLD_FRAMES frames(20)
 #define COUNTER_HIT_THRESHOLD_FRAMES frames(60)
 
+#ifdef BN_MOD_SUPPORT
+// Lists the packages using the most script time, averaged over the battle frames so far
+static void DrawLuaProfile(sf::RenderTarget& surface, frame_time_t battleFrames) {
+  constexpr size_t MAX_ROWS = 6;
+
+  static Font font(Font::Style::thin);
+  Text label{ font };
+  label.setScale(2.f, 2.f);
+
+  float y = 4.f;
+  char row[128];
+
+  auto drawRow = [&] {
+    label.SetString(row);
+    label.setPosition(4.f, y);
+
+    // drop shadow so the rows read over any background
+    label.move(2.f, 2.f);
+    label.SetColor(sf::Color::Black);
+    surface.draw(label);
+
+    label.move(-2.f, -2.f);
+    label.SetColor(sf::Color::White);
+    surface.draw(label);
+
+    y += label.GetLocalBounds().height * label.getScale().y + 2.f;
+  };
+
+  double frameCount = static_cast<double>(std::max<int64_t>(1, battleFrames.count()));
+  std::vector<LuaProfiler::PackageStats> stats = LuaProfiler::Snapshot();
+
+  for (size_t i = 0; i < stats.size() && i < MAX_ROWS; i++) {
+    std::string name = stats[i].name.substr(0, 16);
+    std::snprintf(row, sizeof(row), "%-16s %6.2fMS %5.2f MAX %5.1f CALLS %7lluKB",
+      name.c_str(),
+      stats[i].seconds * 1000.0 / frameCount,
+      stats[i].longestCall * 1000.0,
+      stats[i].calls / frameCount,
+      static_cast<unsigned long long>(stats[i].bytesAllocated / 1024));
+
+    drawRow();
+  }
+
+  LuaProfiler::CollectionStats collection = LuaProfiler::GetCollectionStats();
+  std::snprintf(row, sizeof(row), "%-16s %6.2fMS %5.2f MAX",
+    "GC",
+    collection.seconds * 1000.0 / frameCount,
+    collection.longest * 1000.0);
+
+  drawRow();
+}
+#endif
+
 using swoosh::types::segue;
 using swoosh::Activity;
 using swoosh::ActivityController;
@@ -134,8 +193,10 @@ BattleSceneBase::BattleSceneBase(ActivityController& controller, BattleSceneBase
   counterCombatRule = std::make_shared<CounterCombatRule>(this);
 
   // MOB UI
-  mobBackdropSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_BACKDROP));
-  mobEdgeSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_EDGE));
+  mobBackdropTexture = Textures().LoadFromFile(TexturePaths::MOB_NAME_BACKDROP);
+  mobBackdropSprite = sf::Sprite(*mobBackdropTexture);
+  mobEdgeTexture = Textures().LoadFromFile(TexturePaths::MOB_NAME_EDGE);
+  mobEdgeSprite = sf::Sprite(*mobEdgeTexture);
 
   mobBackdropSprite.setScale(2.f, 2.f);
   mobEdgeSprite.setScale(2.f, 2.f);
@@ -152,6 +213,8 @@ BattleSceneBase::BattleSceneBase(ActivityController& controller, BattleSceneBase
 
   textureSize = getController().getVirtualWindowSize();
 
+  tileQueue.SetAtlas(Textures().GetAtlas());
+
   if (iceShader) {
     iceShader->setUniform("texture", sf::Shader::CurrentTexture);
     iceShader->setUniform("sceneTexture", sf::Shader::CurrentTexture);
@@ -168,6 +231,11 @@ BattleSceneBase::BattleSceneBase(ActivityController& controller, BattleSceneBase
 
   // add the camera to our event bus
   channel.Register(&camera);
+
+#ifdef BN_MOD_SUPPORT
+  // profile each battle on its own
+  LuaProfiler::Reset();
+#endif
 }
 
 BattleSceneBase::~BattleSceneBase() {
@@ -861,6 +929,12 @@ void BattleSceneBase::onDraw(sf::RenderTexture& surface) {
 
   std::vector<Battle::Tile*> allTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
   sf::Vector2f viewOffset = getController().CameraViewOffset(camera);
+  std::vector<sf::Vector2f> yellowBlocks;
+
+  // tiles share a handful of textures and shaders, batch them into a few draw calls
+  // rows are found back to front and each row overlaps the one above it, so every tile and
+  // its children get their own orders. Neighboring tiles with the same states still batch.
+  int order = 0;
 
   for (Battle::Tile* tile : allTiles) {
     if (tile->IsEdgeTile()) continue;
@@ -884,23 +958,29 @@ void BattleSceneBase::onDraw(sf::RenderTexture& surface) {
     tile->PerspectiveFlip(perspectiveFlip);
     tile->move(viewOffset + flipOffset);
     tile->setColor(sf::Color(tint, tint, tint, 255));
-    surface.draw(*tile);
+    order = tileQueue.Submit(*tile, sf::RenderStates::Default, order);
     tile->setColor(sf::Color::White);
 
     if (yellowBlock) {
-      sf::RectangleShape block;
-      block.setSize({40, 30});
-      block.setScale(2.f, 2.f);
-      block.setOrigin(20, 15);
-      block.setFillColor(sf::Color::Yellow);
-      block.setPosition(tile->getPosition());
-      surface.draw(block);
+      yellowBlocks.push_back(tile->getPosition());
     }
 
     tile->move(-(viewOffset+flipOffset));
     tile->PerspectiveFlip(false);
   }
 
+  tileQueue.Flush(surface);
+
+  for (const sf::Vector2f& pos : yellowBlocks) {
+    sf::RectangleShape block;
+    block.setSize({40, 30});
+    block.setScale(2.f, 2.f);
+    block.setOrigin(20, 15);
+    block.setFillColor(sf::Color::Yellow);
+    block.setPosition(pos);
+    surface.draw(block);
+  }
+
   std::vector<Entity*> allEntities;
 
   for (Battle::Tile* tile : allTiles) {
@@ -980,10 +1060,20 @@ void BattleSceneBase::onDraw(sf::RenderTexture& surface) {
 
   // Draw whatever extra state stuff we want to have
   if (current) current->onDraw(surface);
+
+#ifdef BN_MOD_SUPPORT
+  if (LuaProfiler::IsEnabled()) {
+    DrawLuaProfile(surface, frameNumber);
+  }
+#endif
 }
 
 void BattleSceneBase::onEnd()
 {
+#ifdef BN_MOD_SUPPORT
+  LuaProfiler::WriteReport("battle");
+#endif
+
   if (onEndCallback) {
     onEndCallback(battleResults);
   }
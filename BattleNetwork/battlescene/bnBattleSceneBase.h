@@ -28,6 +28,7 @@
 #include "../bnPlayerEmotionUI.h"
 #include "../bnBattleResults.h"
 #include "../bnEventBus.h"
+#include "../bnRenderQueue.h"
 
 // Battle scene specific classes
 #include "bnBattleSceneState.h"
@@ -112,6 +113,7 @@ private:
   std::shared_ptr<PlayerEmotionUI> emotionUI{ nullptr }; /*!< Player's Emotion Window */
   Camera camera; /*!< Camera object - will shake screen */
   sf::Sprite mobEdgeSprite, mobBackdropSprite; /*!< name backdrop images*/
+  std::shared_ptr<sf::Texture> mobEdgeTexture, mobBackdropTexture;
   PA& programAdvance; /*!< PA object loads PA database and returns matching PA card from input */
   std::shared_ptr<Field> field{ nullptr }; /*!< Supplied by mob info: the grid to battle on */
   std::shared_ptr<Player> localPlayer; /*!< Local player */
@@ -158,6 +160,7 @@ private:
   sf::Shader* iceShader; /*!< Reflection in the ice */
   sf::Shader* backdropShader;
   sf::Vector2u textureSize; /*!< Size of distorton effect */
+  RenderQueue tileQueue; /*!< Batches tile sprites each frame */
 
   // backdrop status enum
   enum class backdrop : int {
@@ -18,7 +18,7 @@ struct FreedomMissionProps {
   BattleSceneBaseProps base;
   std::vector<Mob*> mobs;
   uint8_t maxTurns{ 3 };
-  sf::Sprite mug; // speaker mugshot
+  std::shared_ptr<sf::Texture> mug; // speaker mugshot
   Animation anim; // mugshot animation
   std::shared_ptr<sf::Texture> emotion; // emotion atlas image
   std::vector<std::string> blocks;
@@ -21,7 +21,7 @@ struct MobBattleProperties {
     none         //!< No rewards given
   } reward{ };
   std::vector<Mob*> mobs;
-  sf::Sprite mug; // speaker mugshot
+  std::shared_ptr<sf::Texture> mug; // speaker mugshot
   Animation anim; // mugshot animation
   std::shared_ptr<sf::Texture> emotion; // emotion atlas image
   std::vector<std::string> blocks;
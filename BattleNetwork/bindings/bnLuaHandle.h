@@ -0,0 +1,59 @@
+#pragma once
+#ifdef BN_MOD_SUPPORT
+
+#include <sol/sol.hpp>
+
+/*! \brief Holds a value that is handed to lua as the same userdata on every call
+ *
+ * Pushing a usertype by value creates new userdata in the lua heap each time, which is
+ * garbage as soon as the callback returns. Scripted entities pass their WeakWrapper to
+ * callbacks every frame, so the userdata is created the first time the handle is pushed
+ * and the registry reference is pushed after that.
+ *
+ * Only the first lua state the handle is pushed to is cached, other states get a copy.
+ */
+template<typename T>
+class LuaHandle {
+private:
+  T value;
+  mutable sol::main_reference reference; // userdata for value, kept alive by the registry
+public:
+  LuaHandle() {}
+  LuaHandle(const T& value) : value(value) {}
+
+  LuaHandle& operator=(const T& value) {
+    this->value = value;
+    reference = sol::main_reference();
+    return *this;
+  }
+
+  inline T& Get() {
+    return value;
+  }
+
+  inline T* operator->() {
+    return &value;
+  }
+
+  inline int Push(lua_State* L) const {
+    if (reference.valid()) {
+      if (reference.lua_state() == sol::main_thread(L, L)) {
+        return reference.push(L);
+      }
+
+      return sol::stack::push(L, value);
+    }
+
+    int pushed = sol::stack::push(L, value);
+    reference = sol::main_reference(L, -1);
+    return pushed;
+  }
+};
+
+// sol customization point, lets a LuaHandle be passed anywhere sol accepts a value
+template<typename T>
+int sol_lua_push(lua_State* L, const LuaHandle<T>& handle) {
+  return handle.Push(L);
+}
+
+#endif
@@ -2,7 +2,7 @@
 
 #include "bnLuaLibrary.h"
 
-LuaLibrary::LuaLibrary( sol::state& script ) :
+LuaLibrary::LuaLibrary( sol::table& script ) :
     script( script )
     {
     }
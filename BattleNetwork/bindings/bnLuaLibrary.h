@@ -5,10 +5,10 @@
 
 class LuaLibrary
 {
-    sol::state& script;
+    sol::table& script;
 
     public:
-    LuaLibrary( sol::state& script );
+    LuaLibrary( sol::table& script );
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "dynamic_object.h"
 #include "../bnAnimationComponent.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 	/**
 	 * \class ScriptedArtifact
@@ -16,7 +17,7 @@ class ScriptedArtifact final : public Artifact, public dynamic_object
 {
 	std::shared_ptr<AnimationComponent> animationComponent{ nullptr };
 	sf::Vector2f scriptedOffset{ };
-	WeakWrapper<ScriptedArtifact> weakWrap;
+	LuaHandle<WeakWrapper<ScriptedArtifact>> weakWrap;
 
 public:
 	ScriptedArtifact();
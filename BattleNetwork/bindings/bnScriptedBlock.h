@@ -3,10 +3,10 @@
 #include "../bnPlayer.h"
 
 class ScriptedBlock : public PlayerCustScene::Piece {
-  sol::state& script;
+  sol::table& script;
 
 public:
-  ScriptedBlock(sol::state& script);
+  ScriptedBlock(sol::table& script);
   ~ScriptedBlock();
   void run(Player* player);
   std::function<void(Player*)> run_func;
@@ -10,10 +10,10 @@
 class CardImpl;
 
 class ScriptedCard : public CardImpl {
-  sol::state& script;
+  sol::table& script;
 
 public:
-  ScriptedCard(sol::state& script) : script(script) {
+  ScriptedCard(sol::table& script) : script(script) {
 
   }
 
@@ -8,6 +8,7 @@
 #include "../bnCardAction.h"
 #include "../bnAnimation.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 class SpriteProxyNode;
 class Character;
@@ -32,7 +33,7 @@ public:
   sol::object can_move_to_func;
 
 private:
-  WeakWrapper<ScriptedCardAction> weakWrap;
+  LuaHandle<WeakWrapper<ScriptedCardAction>> weakWrap;
 };
 
 #endif
\ No newline at end of file
@@ -28,7 +28,7 @@ void ScriptedCharacter::Init() {
   weakWrap = WeakWrapper(weak_from_base<ScriptedCharacter>());
 }
 
-void ScriptedCharacter::InitFromScript(sol::state& script) {
+void ScriptedCharacter::InitFromScript(sol::table& script) {
   if (!HasInit()) {
     Init();
   }
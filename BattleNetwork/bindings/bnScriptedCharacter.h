@@ -8,6 +8,7 @@
 #include "../bnSolHelpers.h"
 #include "bnScriptedCardAction.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 class AnimationComponent;
 class ScriptedCharacterState;
@@ -27,14 +28,14 @@ class ScriptedCharacter final : public Character, public AI<ScriptedCharacter>,
   bool bossExplosion{ false };
   double explosionPlayback{ 1.0 };
   int numOfExplosions{ 2 };
-  WeakWrapper<ScriptedCharacter> weakWrap;
+  LuaHandle<WeakWrapper<ScriptedCharacter>> weakWrap;
 public:
   using DefaultState = ScriptedCharacterState;
 
   ScriptedCharacter(Character::Rank rank);
   ~ScriptedCharacter();
   void Init();
-  void InitFromScript(sol::state& script);
+  void InitFromScript(sol::table& script);
   void OnSpawn(Battle::Tile& start) override;
   void OnBattleStart() override;
   void OnBattleStop() override;
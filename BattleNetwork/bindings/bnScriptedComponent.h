@@ -6,6 +6,7 @@
 #include "../bnComponent.h"
 #include "../battlescene/bnBattleSceneBase.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 /**
  * @class ScriptedComponent
@@ -28,7 +29,7 @@ public:
   sol::object update_func;
   sol::object scene_inject_func;
 private:
-  WeakWrapper<ScriptedComponent> weakWrap;
+  LuaHandle<WeakWrapper<ScriptedComponent>> weakWrap;
 };
 
 #endif
\ No newline at end of file
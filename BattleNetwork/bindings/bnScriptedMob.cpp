@@ -10,7 +10,7 @@
 //
 // class ScriptedMob::Spawner : public Mob::Spawner<ScriptedCharacter>
 //
-ScriptedMob::ScriptedSpawner::ScriptedSpawner(sol::state& script, const std::string& path, Character::Rank rank)
+ScriptedMob::ScriptedSpawner::ScriptedSpawner(sol::table& script, const std::string& path, Character::Rank rank)
 { 
   scriptedSpawner = std::make_unique<Mob::Spawner<ScriptedCharacter>>(rank);
   std::function<std::shared_ptr<ScriptedCharacter>()> lambda = scriptedSpawner->constructor;
@@ -108,7 +108,7 @@ void ScriptedMob::ScriptedSpawner::SetMob(Mob* mob)
 //
 // class ScriptedMob : public Mob
 // 
-ScriptedMob::ScriptedMob(sol::state& script) : 
+ScriptedMob::ScriptedMob(sol::table& script) : 
   MobFactory(), 
   script(script)
 {
@@ -158,7 +158,7 @@ ScriptedMob::ScriptedSpawner ScriptedMob::CreateSpawner(const std::string& names
     throw std::runtime_error("Character does not exist");
   }
 
-  auto obj = ScriptedMob::ScriptedSpawner(*package->state, package->path, rank);
+  auto obj = ScriptedMob::ScriptedSpawner(package->environment, package->path, rank);
   obj.SetMob(this->mob);
   return obj;
 }
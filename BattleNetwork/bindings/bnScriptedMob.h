@@ -13,7 +13,7 @@
 class ScriptedMob : public MobFactory, public ResourceHandle
 {
 private:
-  sol::state& script;
+  sol::table& script;
   Mob* mob{ nullptr }; //!< ptr for scripts to access
   std::shared_ptr<Field> field{ nullptr };
 
@@ -28,7 +28,7 @@ public:
 
   public:
     ScriptedSpawner() = default;
-    ScriptedSpawner(sol::state& script, const std::string& path, Character::Rank rank);
+    ScriptedSpawner(sol::table& script, const std::string& path, Character::Rank rank);
 
     template<typename BuiltInCharacter>
     void UseBuiltInType(Character::Rank rank);
@@ -37,7 +37,7 @@ public:
     void SetMob(Mob* mob);
   };
 
-  ScriptedMob(sol::state& script);
+  ScriptedMob(sol::table& script);
 
   /**
    * @brief Builds and returns the generated mob
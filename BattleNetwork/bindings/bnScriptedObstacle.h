@@ -6,6 +6,7 @@
 #include "../bnObstacle.h"
 #include "../bnAnimationComponent.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 using sf::Texture;
 
@@ -47,6 +48,6 @@ private:
   float height{};
   std::shared_ptr<AnimationComponent> animComponent{ nullptr };
   std::shared_ptr<DefenseRule> obstacleBody{ nullptr };
-  WeakWrapper<ScriptedObstacle> weakWrap;
+  LuaHandle<WeakWrapper<ScriptedObstacle>> weakWrap;
 };
 #endif
\ No newline at end of file
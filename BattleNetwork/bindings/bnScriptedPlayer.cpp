@@ -5,7 +5,7 @@
 #include "../bnSolHelpers.h"
 #include "../bnCardAction.h"
 
-ScriptedPlayer::ScriptedPlayer(sol::state& script) :
+ScriptedPlayer::ScriptedPlayer(sol::table& script) :
   script(script),
   Player()
 {
@@ -98,7 +98,7 @@ std::shared_ptr<CardAction> ScriptedPlayer::OnExecuteSpecialAction()
 {
   std::shared_ptr<CardAction> result;
 
-  result = activeForm ? activeForm->OnSpecialAction(weakWrap.Lock()) : nullptr;
+  result = activeForm ? activeForm->OnSpecialAction(weakWrap->Lock()) : nullptr;
   if (result) return result;
   
   if (!special_attack_func.valid()) {
@@ -130,7 +130,7 @@ std::shared_ptr<CardAction> ScriptedPlayer::OnExecuteChargedBusterAction()
 {
   std::shared_ptr<CardAction> result;
 
-  result = activeForm ? activeForm->OnChargedBusterAction(weakWrap.Lock()) : nullptr;
+  result = activeForm ? activeForm->OnChargedBusterAction(weakWrap->Lock()) : nullptr;
   if (result) return result;
 
   result = GenerateCardAction(charged_attack_func, "charged_attack_func");
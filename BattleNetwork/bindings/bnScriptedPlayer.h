@@ -14,6 +14,7 @@
 #include "../stx/result.h"
 #include "dynamic_object.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 /*! \brief scriptable navi
  *
@@ -23,16 +24,16 @@
 class ScriptedPlayerFormMeta;
 
 class ScriptedPlayer : public Player, public dynamic_object {
-  sol::state& script;
+  sol::table& script;
   float height{};
 
   std::shared_ptr<CardAction> GenerateCardAction(sol::object& function, const std::string& functionName);
-  WeakWrapper<ScriptedPlayer> weakWrap;
+  LuaHandle<WeakWrapper<ScriptedPlayer>> weakWrap;
 public:
   friend class PlayerControlledState;
   friend class PlayerIdleState;
 
-  ScriptedPlayer(sol::state& script);
+  ScriptedPlayer(sol::table& script);
   ~ScriptedPlayer();
 
   void Init() override;
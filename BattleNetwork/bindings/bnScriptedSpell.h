@@ -6,6 +6,7 @@
 #include "../bnSpell.h"
 #include "../bnAnimationComponent.h"
 #include "bnWeakWrapper.h"
+#include "bnLuaHandle.h"
 
 using sf::Texture;
 
@@ -42,6 +43,6 @@ private:
   float height{};
   sf::Vector2f scriptedOffset{};
   std::shared_ptr<AnimationComponent> animComponent{ nullptr };
-  WeakWrapper<ScriptedSpell> weakWrap;
+  LuaHandle<WeakWrapper<ScriptedSpell>> weakWrap;
 };
 #endif
\ No newline at end of file
@@ -45,7 +45,7 @@ void DefineScriptedCardActionUserType(const std::string& namespaceId, ScriptReso
 
     auto wrappedCharacter = WeakWrapper(character);
     auto functionResult = CallLuaFunctionExpectingValue<WeakWrapper<ScriptedCardAction>>(
-      *cardScriptPackage->state,
+      cardScriptPackage->environment,
       "card_create_action", wrappedCharacter, props
     );
 
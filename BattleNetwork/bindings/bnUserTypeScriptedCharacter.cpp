@@ -57,7 +57,7 @@ void DefineScriptedCharacterUserType(ScriptResourceManager* scriptManager, const
 
       auto character = std::make_shared<ScriptedCharacter>(rank);
       character->SetTeam(team);
-      character->InitFromScript(*scriptPackage->state);
+      character->InitFromScript(scriptPackage->environment);
       character->CreateComponent<MobHealthUI>(character);
 
       auto wrappedCharacter = WeakWrapper(std::static_pointer_cast<Character>(character));
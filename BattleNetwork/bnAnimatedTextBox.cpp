@@ -161,12 +161,14 @@ void AnimatedTextBox::DequeMessage() {
   // We need an image of the last speaker when we close
   if (messages.size() == 1) {
     lastSpeaker = *mugshots.begin();
+    lastSpeakerTexture = *mugshotTextures.begin();
   }
 
   delete *messages.begin(); // TODO: use shared ptrs
   messages.erase(messages.begin());
   anims.erase(anims.begin());
   mugshots.erase(mugshots.begin());
+  mugshotTextures.erase(mugshotTextures.begin());
 
   isPaused = false; // Begin playing again
 
@@ -174,6 +176,7 @@ void AnimatedTextBox::DequeMessage() {
 
   // If we have a new speaker, use their image instead
   lastSpeaker = *mugshots.begin();
+  lastSpeakerTexture = *mugshotTextures.begin();
   mugAnimator = Animation(anims[0]);
   mugAnimator.SetAnimation("TALK");
   mugAnimator << Animator::Mode::Loop;
@@ -197,9 +200,11 @@ void AnimatedTextBox::EnqueMessage(const sf::Sprite& speaker, const Animation& a
 
   mugshots.push_back(speaker);
   mugshots[mugshots.size() - 1].setScale(2.f, 2.f);
+  mugshotTextures.push_back(nullptr);
 
   if (messages.size() == 1) {
     lastSpeaker = mugshots.front();
+    lastSpeakerTexture = nullptr;
     mugAnimator = mugAnim;
     textBox.SetText(message->GetMessage());
   }
@@ -208,6 +213,16 @@ void AnimatedTextBox::EnqueMessage(const sf::Sprite& speaker, const Animation& a
   message->SetTextBox(this);
 }
 
+void AnimatedTextBox::EnqueMessage(const std::shared_ptr<Texture>& mugshot, const Animation& anim, MessageInterface* message)
+{
+  EnqueMessage(mugshot ? sf::Sprite(*mugshot) : sf::Sprite{}, anim, message);
+  mugshotTextures.back() = mugshot;
+
+  if (messages.size() == 1) {
+    lastSpeakerTexture = mugshot;
+  }
+}
+
 void AnimatedTextBox::EnqueMessage(MessageInterface* message) {
   EnqueMessage(sf::Sprite{}, Animation{}, message);
 }
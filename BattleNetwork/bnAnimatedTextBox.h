@@ -33,7 +33,9 @@ private:
   double totalTime{}; /*!< elapsed */
   double textSpeed{1.0}; /*!< desired speed of text */
   mutable std::vector<sf::Sprite> mugshots; /*!< List of current and next mugshots */
+  std::vector<std::shared_ptr<Texture>> mugshotTextures; /*!< textures of the mugshots above when the textbox owns them */
   mutable sf::Sprite lastSpeaker;
+  std::shared_ptr<Texture> lastSpeakerTexture; /*!< keeps the last mugshot drawable after its message is dequeued */
   std::vector<Animation> anims; /*!< List of animation paths for the mugshots */
   std::vector<MessageInterface*> messages; /*!< Lists of current and next messages */
   mutable sf::Sprite frame; /*!< Size is calculated from the frame sprite */
@@ -64,6 +66,14 @@ public:
    * @param message message object
    */
   void EnqueMessage(const sf::Sprite& speaker, const Animation& anim, MessageInterface* message);
+
+  /**
+   * @brief Adds message and mugshot to queue, the textbox holds the mugshot texture until the message is gone
+   * @param mugshot mugshot texture
+   * @param animation mugshot animation
+   * @param message message object
+   */
+  void EnqueMessage(const std::shared_ptr<Texture>& mugshot, const Animation& anim, MessageInterface* message);
   
   /**
    * @brief Adds message to queue
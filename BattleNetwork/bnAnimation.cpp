@@ -3,13 +3,69 @@ using sf::Sprite;
 using sf::IntRect;
 
 #include "bnAnimation.h"
+#include "bnCompiledAnimation.h"
 #include "bnFileUtil.h"
 #include "bnLogger.h"
 #include "bnEntity.h"
+#include "bnCurrentTime.h"
 #include <cmath>
 #include <chrono>
 #include <string_view>
 #include <cstdlib>
+#include <mutex>
+
+// TODO: mac os < 10.5 file system support...
+#ifndef __APPLE__
+#include <filesystem>
+#endif
+
+namespace {
+  /*! \brief Size and modified time of an animation file, a mod replacing the file changes them */
+  struct FileStamp {
+    uint64_t size{};
+    int64_t modified{};
+
+    bool operator==(const FileStamp& other) const {
+      return size == other.size && modified == other.modified;
+    }
+  };
+
+  /*! \brief Parsed animation file shared by every Animation loaded from the same path */
+  struct CachedStates {
+    std::shared_ptr<const Animation::StateMap> states;
+    FileStamp stamp; //!< of the file the states were parsed from
+    long long lastRequestTime{};
+  };
+
+  constexpr long long IDLE_TIME_MS = 60000;
+  constexpr long long SWEEP_INTERVAL_MS = 1000; //!< how often HandleExpiredAnimationCache() looks for idle files
+
+  std::mutex cacheMutex; //!< Animations are also loaded on worker threads
+  std::map<std::string, CachedStates> statesFromPath;
+  long long lastSweepTime{}; //!< only touched by the thread calling HandleExpiredAnimationCache()
+
+  const FrameList emptyFrameList;
+
+  FileStamp GetFileStamp(const std::string& path) {
+    FileStamp stamp;
+
+#ifndef __APPLE__
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+
+    if (ec) return stamp;
+
+    auto modified = std::filesystem::last_write_time(path, ec);
+
+    if (ec) return stamp;
+
+    stamp.size = static_cast<uint64_t>(size);
+    stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+#endif
+
+    return stamp;
+  }
+}
 
 Animation::Animation() : animator(), path("") {
   progress = frames(0);
@@ -48,8 +104,8 @@ void Animation::CopyFrom(const Animation& rhs)
 
 void Animation::Reload() {
   if (path != "") {
-    string data = FileUtil::Read(path);
-    LoadWithData(data);
+    progress = frames(0);
+    MergeStates(LoadStatesFromFile(path));
   }
 }
 
@@ -150,8 +206,115 @@ static bool GetBoolValue(std::string_view line, std::string_view key) {
   return valueView == "1" || valueView == "true";
 }
 
+std::shared_ptr<const Animation::StateMap> Animation::LoadStatesFromFile(const string& path)
+{
+  FileStamp stamp = GetFileStamp(path);
+
+  {
+    std::scoped_lock lock(cacheMutex);
+    auto iter = statesFromPath.find(path);
+
+    // a file changed on disk is parsed again, animations already holding the old states keep them
+    if (iter != statesFromPath.end() && iter->second.stamp == stamp) {
+      iter->second.lastRequestTime = CurrentTime::AsMilli();
+      return iter->second.states;
+    }
+  }
+
+  // load outside of the lock, another thread may race us to the same file
+  std::string source = FileUtil::Read(path);
+  std::shared_ptr<const StateMap> states = CompiledAnimation::Load(path, source);
+
+  if (!states) {
+    std::shared_ptr<StateMap> parsed = ParseStates(source, path);
+    CompiledAnimation::Save(path, source, *parsed);
+    states = parsed;
+  }
+
+  std::scoped_lock lock(cacheMutex);
+  auto [iter, inserted] = statesFromPath.try_emplace(path, CachedStates{ states, stamp });
+
+  if (!inserted && !(iter->second.stamp == stamp)) {
+    iter->second.states = states;
+    iter->second.stamp = stamp;
+  }
+
+  iter->second.lastRequestTime = CurrentTime::AsMilli();
+
+  return iter->second.states;
+}
+
+void Animation::HandleExpiredAnimationCache()
+{
+  long long now = CurrentTime::AsMilli();
+
+  // called every frame, only walk the cache once a second
+  if (now - lastSweepTime < SWEEP_INTERVAL_MS) return;
+
+  lastSweepTime = now;
+
+  std::scoped_lock lock(cacheMutex);
+  auto iter = statesFromPath.begin();
+
+  while (iter != statesFromPath.end()) {
+    // only the cache is holding on to this file
+    if (iter->second.states.use_count() == 1 && now - iter->second.lastRequestTime > IDLE_TIME_MS) {
+      Logger::Logf(LogLevel::debug, "Animation data %s expired", iter->first.c_str());
+      iter = statesFromPath.erase(iter);
+      continue;
+    }
+
+    iter++;
+  }
+}
+
+void Animation::MergeStates(const std::shared_ptr<const StateMap>& states)
+{
+  if (!animations || animations->empty()) {
+    animations = states;
+    return;
+  }
+
+  StateMap& ownStates = GetMutableStates();
+  ownStates.insert(states->begin(), states->end());
+}
+
+Animation::StateMap& Animation::GetMutableStates()
+{
+  if (!animations) {
+    animations = std::make_shared<StateMap>();
+  }
+  else if (animations.use_count() > 1) {
+    // shared with the cache or other copies of this animation
+    animations = std::make_shared<StateMap>(*animations);
+  }
+
+  // we are the only owner
+  return const_cast<StateMap&>(*animations);
+}
+
+const FrameList& Animation::GetState(const string& state) const
+{
+  if (!animations) return emptyFrameList;
+
+  auto iter = animations->find(state);
+
+  if (iter == animations->end()) {
+    return emptyFrameList;
+  }
+
+  return iter->second;
+}
+
 void Animation::LoadWithData(const string& data)
 {
+  progress = frames(0);
+  MergeStates(ParseStates(data, path));
+}
+
+std::shared_ptr<Animation::StateMap> Animation::ParseStates(const string& data, const string& path)
+{
+  std::shared_ptr<StateMap> animations = std::make_shared<StateMap>();
   int frameAnimationIndex = -1;
   vector<FrameList> frameLists;
   string currentState = "";
@@ -159,7 +322,6 @@ void Animation::LoadWithData(const string& data)
   int currentWidth = 0;
   int currentHeight = 0;
   bool legacySupport = false;
-  progress = frames(0);
 
   std::string_view dataView = data;
   size_t endLine = 0;
@@ -197,7 +359,7 @@ void Animation::LoadWithData(const string& data)
 
         std::transform(currentState.begin(), currentState.end(), currentState.begin(), ::toupper);
 
-        animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
+        animations->insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
         currentAnimationDuration = frames(0);
       }
       currentState = GetValue(line, "state");
@@ -291,8 +453,10 @@ void Animation::LoadWithData(const string& data)
   // One more addAnimation to do if file is good
   if (frameAnimationIndex >= 0) {
     std::transform(currentState.begin(), currentState.end(), currentState.begin(), ::toupper);
-    animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
+    animations->insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
   }
+
+  return animations;
 }
 
 void Animation::HandleInterrupted()
@@ -300,7 +464,7 @@ void Animation::HandleInterrupted()
   if (handlingInterrupt) return;
   handlingInterrupt = true;
 
-  if (interruptCallback && progress < animations[currAnimation].GetTotalDuration()) {
+  if (interruptCallback && progress < GetState(currAnimation).GetTotalDuration()) {
     interruptCallback();
     interruptCallback = nullptr;
   }
@@ -317,8 +481,11 @@ void Animation::Update(double elapsed, sf::Sprite& target) {
 
   std::string stateNow = currAnimation;
 
+  // callbacks may replace our states, keep these alive until the animator returns
+  std::shared_ptr<const StateMap> states = animations;
+
   if (noAnim == false) {
-    animator(progress, target, animations[currAnimation]);
+    animator(progress, target, GetState(currAnimation));
   }
   else {
     // effectively hide
@@ -328,13 +495,13 @@ void Animation::Update(double elapsed, sf::Sprite& target) {
   if(currAnimation != stateNow) {
     // it was changed during a callback
     // apply new state to target on same frame
-    animator(frames(0), target, animations[currAnimation]);
+    animator(frames(0), target, GetState(currAnimation));
     progress = frames(0);
     
     HandleInterrupted();
   }
 
-  const frame_time_t duration = animations[currAnimation].GetTotalDuration();
+  const frame_time_t duration = GetState(currAnimation).GetTotalDuration();
 
   if(duration <= frames(0)) return;
 
@@ -348,7 +515,7 @@ void Animation::SyncTime(frame_time_t newTime)
 {
   progress = newTime;
 
-  const frame_time_t duration = animations[currAnimation].GetTotalDuration();
+  const frame_time_t duration = GetState(currAnimation).GetTotalDuration();
 
   if (duration <= frames(0)) return;
 
@@ -360,21 +527,22 @@ void Animation::SyncTime(frame_time_t newTime)
 
 void Animation::SetFrame(int frame, sf::Sprite& target)
 {
-  if(path.empty() || animations.empty() || animations.find(currAnimation) == animations.end()) return;
+  if(path.empty() || !animations || animations->find(currAnimation) == animations->end()) return;
 
-  auto size = animations[currAnimation].GetFrameCount();
+  const FrameList& frameList = GetState(currAnimation);
+  auto size = frameList.GetFrameCount();
 
   if (frame <= 0 || frame > size) {
     progress = frames(0);
-    animator.SetFrame(int(size), target, animations[currAnimation]);
+    animator.SetFrame(int(size), target, frameList);
 
   }
   else {
-    animator.SetFrame(frame, target, animations[currAnimation]);
+    animator.SetFrame(frame, target, frameList);
     progress = frames(0);
 
     while (frame) {
-      progress += animations[currAnimation].GetFrame(--frame).duration;
+      progress += frameList.GetFrame(--frame).duration;
     }
   }
 }
@@ -386,18 +554,16 @@ void Animation::SetAnimation(string state) {
 
   std::transform(state.begin(), state.end(), state.begin(), ::toupper);
 
-  auto pos = animations.find(state);
-
   noAnim = false; // presumptious reset
 
-  if (pos == animations.end()) {
+  if (!animations || animations->find(state) == animations->end()) {
 #ifdef BN_LOG_MISSING_STATE
     Logger::Log("No animation found in file for \"" + state + "\"");
 #endif
     noAnim = true;
   }
   else {
-    animator.UpdateCurrentPoints(0, pos->second);
+    animator.UpdateCurrentPoints(0, GetState(state));
   }
 
   // Even if we don't have this animation, switch to it anyway
@@ -415,10 +581,10 @@ const std::string Animation::GetAnimationString() const
   return currAnimation;
 }
 
-FrameList & Animation::GetFrameList(std::string animation)
+const FrameList& Animation::GetFrameList(std::string animation) const
 {
   std::transform(animation.begin(), animation.end(), animation.begin(), ::toupper);
-  return animations[animation];
+  return GetState(animation);
 }
 
 Animation & Animation::operator<<(const Animator::On& rhs)
@@ -443,14 +609,19 @@ void Animation::operator<<(const std::function<void()>& onFinish)
   animator << onFinish;
 }
 
-sf::Vector2f Animation::GetPoint(const std::string & pointName)
+sf::Vector2f Animation::GetPoint(PointId id) const
 {
-  std::string point = pointName;
-  std::transform(point.begin(), point.end(), point.begin(), ::toupper);
+  return animator.GetPoint(id);
+}
 
-  const sf::Vector2f res = animator.GetPoint(point);
+const bool Animation::HasPoint(PointId id) const
+{
+  return animator.HasPoint(id);
+}
 
-  return res;
+sf::Vector2f Animation::GetPoint(const std::string & pointName)
+{
+  return animator.GetPoint(pointName);
 }
 
 const bool Animation::HasPoint(const std::string& pointName)
@@ -465,13 +636,7 @@ char Animation::GetMode()
 
 frame_time_t Animation::GetStateDuration(const std::string& state) const
 {
-  auto iter = animations.find(state);
-  
-  if (iter != animations.end()) {
-    return iter->second.GetTotalDuration();
-  }
-  
-  return frames(0);
+  return GetState(state).GetTotalDuration();
 }
 
 void Animation::OverrideAnimationFrames(const std::string& animation, const std::list<OverrideFrame>&data, std::string& uuid)
@@ -483,9 +648,10 @@ void Animation::OverrideAnimationFrames(const std::string& animation, const std:
     uuid = animation + "@" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
   }
 
-  if (animations.find(uuid) != animations.end()) return;
+  if (HasAnimation(uuid)) return;
 
-  animations.emplace(uuid, std::move(animations[animation].MakeNewFromOverrideData(data)));
+  FrameList overrideList = GetState(animation).MakeNewFromOverrideData(data);
+  GetMutableStates().emplace(uuid, std::move(overrideList));
 }
 
 void Animation::SyncAnimation(Animation& other)
@@ -501,7 +667,7 @@ void Animation::SetInterruptCallback(const std::function<void()> onInterrupt)
 
 const bool Animation::HasAnimation(const std::string& state) const
 {
-  return animations.find(state) != animations.end();
+  return animations && animations->find(state) != animations->end();
 }
 
 const double Animation::GetPlaybackSpeed() const
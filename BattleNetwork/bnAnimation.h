@@ -4,6 +4,7 @@
 #include <functional>
 
 #include <iostream>
+#include <memory>
 
 #include "bnAnimator.h"
 
@@ -44,9 +45,14 @@ using std::to_string;
  * ```
  *
  * etc.
+ *
+ * Parsed files are shared between every Animation loaded from the same path.
+ * An instance only makes its own copy of the states when OverrideAnimationFrames is used.
  */
 class Animation {
 public:
+  using StateMap = std::map<string, FrameList>;
+
   /**
    * @brief No frame list is loaded*/
   Animation();
@@ -140,9 +146,9 @@ public:
    * @brief Get the frame list corresponding to this animation state
    * @param animation name of the animation
    * @return FrameList&
-   * @warning Make sure this animation exists otherwise could return an empty frame list or throw
+   * @warning Make sure this animation exists otherwise returns an empty frame list
    */
-  FrameList& GetFrameList(std::string animation);
+  const FrameList& GetFrameList(std::string animation) const;
 
   /**
    * @brief Append frame callback
@@ -171,6 +177,12 @@ public:
    */
   void operator<<(const std::function<void()>& onFinish);
 
+  sf::Vector2f GetPoint(PointId id) const;
+  const bool HasPoint(PointId id) const;
+
+  /**
+   * @brief Looks up points by label for scripts, prefer the PointId overloads in engine code
+   */
   sf::Vector2f GetPoint(const std::string& pointName);
   const bool HasPoint(const std::string& pointName);
 
@@ -203,8 +215,40 @@ public:
     return *this;
   }
 
+  /**
+  * @brief Frees parsed animation files that no Animation has used for a while, cheap enough to call every frame
+  */
+  static void HandleExpiredAnimationCache();
+
+  /**
+  * @brief Parses animation file data into a new set of states
+  * @param path used for error messages only
+  */
+  static std::shared_ptr<StateMap> ParseStates(const string& data, const string& path);
+
 private:
   void HandleInterrupted();
+
+  /**
+  * @brief Returns the states loaded from path, parsing the file only if it is not cached or changed since
+  */
+  static std::shared_ptr<const StateMap> LoadStatesFromFile(const string& path);
+
+  /**
+  * @brief Merges states into this animation, keeps existing states with the same name
+  */
+  void MergeStates(const std::shared_ptr<const StateMap>& states);
+
+  /**
+  * @brief Copy on write, returns states only owned by this animation
+  */
+  StateMap& GetMutableStates();
+
+  /**
+  * @brief Get the frame list for state
+  * @return an empty frame list if the state does not exist
+  */
+  const FrameList& GetState(const string& state) const;
 protected:
   bool noAnim{ false }; /*!< If the requested state was not found, hide the sprite when updating */
   bool handlingInterrupt{ false }; /*!< Whether or not the interupt handler is executing (for nested animations) */
@@ -213,6 +257,6 @@ protected:
   string currAnimation; /*!< Name of the current animation state */
   frame_time_t progress; /*!< Current progress of animation */
   double playbackSpeed{ 1.0 }; /*!< Factor to multiply against update `dt`*/
-  std::map<string, FrameList> animations; /*!< Dictionary of FrameLists read from file */
+  std::shared_ptr<const StateMap> animations; /*!< Dictionary of FrameLists read from file, shared with other animations */
   std::function<void()> interruptCallback;
 };
@@ -161,11 +161,21 @@ sf::Vector2f AnimationComponent::GetPoint(const std::string & pointName)
   return animation.GetPoint(pointName);
 }
 
+sf::Vector2f AnimationComponent::GetPoint(PointId id) const
+{
+  return animation.GetPoint(id);
+}
+
 const bool AnimationComponent::HasPoint(const std::string& pointName)
 {
   return animation.HasPoint(pointName);
 }
 
+const bool AnimationComponent::HasPoint(PointId id) const
+{
+  return animation.HasPoint(id);
+}
+
 Animation & AnimationComponent::GetAnimationObject()
 {
   return animation;
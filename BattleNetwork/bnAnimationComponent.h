@@ -29,7 +29,7 @@ public:
   struct SyncItem {
     Animation* anim{ nullptr };
     std::shared_ptr<SpriteProxyNode> node{ nullptr };
-    std::string point{ "origin" };
+    PointId point{ PointNames::ORIGIN };
   };
 
   /**
@@ -145,8 +145,10 @@ public:
    * @return (x,y) vector of point or (0,0) if no point found
    */
   sf::Vector2f GetPoint(const std::string& pointName);
+  sf::Vector2f GetPoint(PointId id) const;
 
   const bool HasPoint(const std::string& pointName);
+  const bool HasPoint(PointId id) const;
 
   Animation& GetAnimationObject();
   
@@ -1,6 +1,72 @@
 #include "bnAnimator.h"
 
 #include <iostream>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+  /*! \brief Label table behind PointNames, ORIGIN is always the first entry */
+  struct PointNameTable {
+    std::mutex mutex;
+    std::unordered_map<std::string, PointId> ids;
+    std::deque<std::string> names; //!< deque so references returned by GetName stay valid
+
+    PointNameTable() {
+      ids.emplace("ORIGIN", PointNames::ORIGIN);
+      names.emplace_back("ORIGIN");
+    }
+  };
+
+  PointNameTable& GetPointNameTable() {
+    static PointNameTable table;
+    return table;
+  }
+
+  std::string ToUpper(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+    return str;
+  }
+}
+
+PointId PointNames::Intern(const std::string& name)
+{
+  std::string key = ToUpper(name);
+  PointNameTable& table = GetPointNameTable();
+  std::scoped_lock lock(table.mutex);
+
+  auto [iter, inserted] = table.ids.try_emplace(std::move(key), static_cast<PointId>(table.names.size()));
+
+  if (inserted) {
+    table.names.push_back(iter->first);
+  }
+
+  return iter->second;
+}
+
+bool PointNames::Find(const std::string& name, PointId& id)
+{
+  std::string key = ToUpper(name);
+  PointNameTable& table = GetPointNameTable();
+  std::scoped_lock lock(table.mutex);
+
+  auto iter = table.ids.find(key);
+
+  if (iter == table.ids.end()) {
+    return false;
+  }
+
+  id = iter->second;
+  return true;
+}
+
+const std::string& PointNames::GetName(PointId id)
+{
+  PointNameTable& table = GetPointNameTable();
+  std::scoped_lock lock(table.mutex);
+  return table.names.at(id);
+}
 
 Animator::Mode::Mode(int playback)
 {
@@ -89,6 +155,8 @@ Animator & Animator::operator=(const Animator & rhs)
   isUpdating = rhs.isUpdating;
   callbacksAreValid = rhs.callbacksAreValid;
   currentPoints = rhs.currentPoints;
+  pointsRevision = rhs.pointsRevision;
+  pointsIndex = rhs.pointsIndex;
   playbackMode = rhs.playbackMode;
 
   return *this;
@@ -104,18 +172,24 @@ Animator::~Animator() {
   queuedOnFinish = nullptr;
 }
 
-void Animator::UpdateCurrentPoints(int frameIndex, FrameList& sequence) {
+void Animator::UpdateCurrentPoints(int frameIndex, const FrameList& sequence) {
   if (sequence.frames.size() <= frameIndex) return;
 
+  // points are already up to date for this frame
+  if (pointsRevision == sequence.revision && pointsIndex == frameIndex) return;
+
+  pointsRevision = sequence.revision;
+  pointsIndex = frameIndex;
+
   auto& data = sequence.frames[frameIndex];
   currentPoints = data.points;
 
-  for (auto& [key, point] : currentPoints) {
-    point = CalculatePointData(point, data);
+  for (FramePoint& point : currentPoints) {
+    point.value = CalculatePointData(point.value, data);
   }
 }
 
-void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList& sequence) {
+void Animator::operator() (frame_time_t progress, sf::Sprite& target, const FrameList& sequence) {
   frame_time_t startProgress = progress;
 
   // If we did not progress while in an update, do not merge the queues and ignore this request 
@@ -177,138 +251,123 @@ void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList&
     return;
   }
 
-  // We may modify the frame order, make a copy
-  std::vector<Frame> copy = sequence.frames;
-
-  // If the playback mode is reverse, flip the frames
-  if ((playbackMode & Mode::Reverse) == Mode::Reverse) {
-    reverse(copy.begin(), copy.end());
-  }
+  // Frames are never copied or reversed, the playback direction picks the view into the list
+  bool reversed = (playbackMode & Mode::Reverse) == Mode::Reverse;
+  const size_t lastPosition = sequence.frames.size() - 1u;
 
   // frame index
   int index = 0;
 
-  // Iterator to the frame itself
-  std::vector<Frame>::const_iterator iter = copy.begin();
+  // Position of the frame in playback order
+  size_t position = 0;
 
   // While there is time left in the progress loop
   while (progress > frames(0)) {
-    // Increase the index
-    index++;
+    // Jump to the frame the progress lands on, or the last frame if we run out of frames
+    // Frames ending exactly on the progress are landed on to handle case (progress == frame.duration) correctly
+    size_t landed = sequence.FindFrame(position, progress, reversed);
+
+    // The index counts every frame stepped through
+    index += static_cast<int>(landed - position) + 1;
 
     // Subtract from the progress
-    progress -= (*iter).duration;
+    progress -= sequence.GetStartTime(landed + 1u, reversed) - sequence.GetStartTime(position, reversed);
+    position = landed;
 
-    // Must be <= and not <, to handle case (progress == frame.duration) correctly
-    // We assume progress hits zero because we use it as a decrementing counter
     // We add a check to ensure the start progress wasn't also 0
     // If it did not start at zero, we know we came across the end of the animation
-    bool reachedLastFrame = &(*iter) == &copy.back() && startProgress != frames(0);
+    bool reachedLastFrame = position == lastPosition && startProgress != frames(0);
 
-    if (progress <= frames(0) || reachedLastFrame) {
-      FrameCallbackHash::iterator callbackIter = callbacks.begin();
-      FrameCallbackHash::iterator callbackFind = callbacks.find(index);
-      FrameCallbackHash::iterator onetimeCallbackIter = onetimeCallbacks.find(index);
+    FrameCallbackHash::iterator callbackIter = callbacks.begin();
+    FrameCallbackHash::iterator callbackFind = callbacks.find(index);
+    FrameCallbackHash::iterator onetimeCallbackIter = onetimeCallbacks.find(index);
 
-      // step through and execute any callbacks that haven't triggerd up to this frame
-      while (callbacksAreValid && callbacks.size() && callbackIter != callbackFind && callbackFind != callbacks.end()) {
-        if (callbackIter->second) {
-          callbackIter->second();
-        }
+    // step through and execute any callbacks that haven't triggerd up to this frame
+    while (callbacksAreValid && callbacks.size() && callbackIter != callbackFind && callbackFind != callbacks.end()) {
+      if (callbackIter->second) {
+        callbackIter->second();
+      }
 
-        // If the callback modified the first callbacks list, break
-        if (!callbacksAreValid) break;
+      // If the callback modified the first callbacks list, break
+      if (!callbacksAreValid) break;
 
-        // Otherwise add the callback into the next loop queue
-        nextLoopCallbacks.insert(*callbackIter);
+      // Otherwise add the callback into the next loop queue
+      nextLoopCallbacks.insert(*callbackIter);
 
-        // Erase the callback so we don't fire again
-        callbackIter = callbacks.erase(callbackIter);
+      // Erase the callback so we don't fire again
+      callbackIter = callbacks.erase(callbackIter);
 
-        // Find the callback at the given index b/c iterator will be invalidated
-        callbackFind = callbacks.find(index);
-      }
-
-      // If callbacks are ok and the iterator matches the expected frame
-      if (callbacksAreValid && callbacks.size() && callbackIter == callbackFind && callbackFind != callbacks.end()) {
-        if (callbackIter->second) {
-          callbackIter->second();
-        }
+      // Find the callback at the given index b/c iterator will be invalidated
+      callbackFind = callbacks.find(index);
+    }
 
-        if (callbacksAreValid) {
-          nextLoopCallbacks.insert(*callbackIter);
-          callbackIter = callbacks.erase(callbackIter);
-        }
+    // If callbacks are ok and the iterator matches the expected frame
+    if (callbacksAreValid && callbacks.size() && callbackIter == callbackFind && callbackFind != callbacks.end()) {
+      if (callbackIter->second) {
+        callbackIter->second();
       }
 
-      if (callbacksAreValid && onetimeCallbackIter != onetimeCallbacks.end()) {
-        if (onetimeCallbackIter->second) {
-          onetimeCallbackIter->second();
-        }
-
-        if (callbacksAreValid) {
-          onetimeCallbacks.erase(onetimeCallbackIter);
-        }
+      if (callbacksAreValid) {
+        nextLoopCallbacks.insert(*callbackIter);
+        callbackIter = callbacks.erase(callbackIter);
       }
+    }
 
-      // Determine if the progress has completed the animation
-      // NOTE: Last frame doesn't mean all the time has been used. Check for total duration
-      if (reachedLastFrame && startProgress >= sequence.totalDuration && callbacksAreValid) {
-        if (onFinish != nullptr) {
-          // If applicable, fire the onFinish callback
-          onFinish();
-
-          // If we do not loop the animation, empty the onFinish notifier. If we don't empty the notifier, this fires infinitely...
-          if ((playbackMode & Mode::Loop) != Mode::Loop) {
-            onFinish = nullptr;
-          }
-        }
+    if (callbacksAreValid && onetimeCallbackIter != onetimeCallbacks.end()) {
+      if (onetimeCallbackIter->second) {
+        onetimeCallbackIter->second();
       }
 
-      // If the playback mode was set to loop...
-      if ((playbackMode & Mode::Loop) == Mode::Loop && &(*iter) == &copy.back() && startProgress >= sequence.totalDuration) {
-        // But it was also set to bounce, reverse the list and start over
-        if ((playbackMode & Mode::Bounce) == Mode::Bounce) {
-          reverse(copy.begin(), copy.end());
-          iter = copy.begin();
-          iter++;
-        }
-        else {
-          // It was set only to loop, start from the beginning
-          iter = copy.begin();
-        }
-
-        if (callbacksAreValid) {
-          // Clear callbacks
-          callbacks.clear();
+      if (callbacksAreValid) {
+        onetimeCallbacks.erase(onetimeCallbackIter);
+      }
+    }
 
-          // Enqueue the callbacks for the next round
-          callbacks = nextLoopCallbacks;
-          nextLoopCallbacks.clear();
+    // Determine if the progress has completed the animation
+    // NOTE: Last frame doesn't mean all the time has been used. Check for total duration
+    if (reachedLastFrame && startProgress >= sequence.totalDuration && callbacksAreValid) {
+      if (onFinish != nullptr) {
+        // If applicable, fire the onFinish callback
+        onFinish();
 
-          // callbacksAreValid = true;
+        // If we do not loop the animation, empty the onFinish notifier. If we don't empty the notifier, this fires infinitely...
+        if ((playbackMode & Mode::Loop) != Mode::Loop) {
+          onFinish = nullptr;
         }
+      }
+    }
 
-        continue; // Start loop again
+    // If the playback mode was set to loop...
+    if ((playbackMode & Mode::Loop) == Mode::Loop && position == lastPosition && startProgress >= sequence.totalDuration) {
+      // But it was also set to bounce, play the other direction skipping the frame we ended on
+      if ((playbackMode & Mode::Bounce) == Mode::Bounce) {
+        reversed = !reversed;
+        position = std::min<size_t>(1u, lastPosition);
       }
+      else {
+        // It was set only to loop, start from the beginning
+        position = 0;
+      }
+
+      if (callbacksAreValid) {
+        // Clear callbacks
+        callbacks.clear();
 
-      // apply rect, flip, and origin attributes
-      UpdateSpriteAttributes(target, *iter);
+        // Enqueue the callbacks for the next round
+        callbacks = nextLoopCallbacks;
+        nextLoopCallbacks.clear();
 
-      UpdateCurrentPoints(index - 1, sequence);
+        // callbacksAreValid = true;
+      }
 
-      break;
+      continue; // Start loop again
     }
 
-    // If not finish, go to next frame
-    iter++;
+    break;
   }
 
-  // If we prematurely ended the loop, update the sprite
-  if (iter != copy.end()) {
-    // apply rect, flip, and origin attributes
-    UpdateSpriteAttributes(target, *iter);
-  }
+  // apply rect, flip, and origin attributes
+  UpdateSpriteAttributes(target, sequence.GetFrameAt(position, reversed));
 
   // End updating flag
   isUpdating = false;
@@ -391,28 +450,43 @@ char Animator::GetMode()
   return playbackMode;
 }
 
+const sf::Vector2f Animator::GetPoint(PointId id) const {
+  for (const FramePoint& point : currentPoints) {
+    if (point.id == id) return point.value;
+  }
+
+#ifdef BN_LOG_MISSING_POINT
+  Logger::Log("Could not find point in current sequence named " + PointNames::GetName(id));
+#endif
+  return sf::Vector2f();
+}
+
+const bool Animator::HasPoint(PointId id) const
+{
+  for (const FramePoint& point : currentPoints) {
+    if (point.id == id) return true;
+  }
+
+  return false;
+}
+
 const sf::Vector2f Animator::GetPoint(const std::string& pointName) {
-  std::string str = pointName;
-  std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-  if (currentPoints.find(str) == currentPoints.end()) {
+  PointId id{};
+
+  if (!PointNames::Find(pointName, id)) {
 #ifdef BN_LOG_MISSING_POINT
-    Logger::Log("Could not find point in current sequence named " + str);
+    Logger::Log("Could not find point in current sequence named " + pointName);
 #endif
     return sf::Vector2f();
   }
-  return currentPoints[str];
+
+  return GetPoint(id);
 }
 
 const bool Animator::HasPoint(const std::string& pointName)
 {
-  std::string str = pointName;
-  std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-
-  if (currentPoints.find(str) == currentPoints.end()) {
-    return false;
-  }
-
-  return true;
+  PointId id{};
+  return PointNames::Find(pointName, id) && HasPoint(id);
 }
 
 void Animator::Clear() {
@@ -429,10 +503,10 @@ void Animator::Clear() {
   }
 }
 
-void Animator::SetFrame(int frameIndex, sf::Sprite& target, FrameList& sequence)
+void Animator::SetFrame(int frameIndex, sf::Sprite& target, const FrameList& sequence)
 {
   int index = 0;
-  for (Frame& frame : sequence.frames) {
+  for (const Frame& frame : sequence.frames) {
     index++;
 
     if (index == frameIndex) {
@@ -6,6 +6,8 @@
 #include <assert.h>
 #include <iostream>
 #include <list>
+#include <atomic>
+#include <cstdint>
 
 #include "bnLogger.h"
 #include "frame_time_t.h"
@@ -13,7 +15,45 @@
 using FrameCallback = std::function<void()>;
 using FrameFinishCallback = std::function<void()>;
 using FrameCallbackHash = std::multimap<int, FrameCallback>;
-using PointHash = std::map<std::string, sf::Vector2f>;
+using PointId = uint32_t;
+
+/**
+ * @class PointNames
+ * @brief Interns point labels so frames and animators compare small integers instead of strings
+ *
+ * Labels are case-insensitive. IDs are never released and are safe to share between threads.
+ */
+class PointNames {
+public:
+  static constexpr PointId ORIGIN = 0; /*!< Every frame has an origin point */
+
+  /**
+   * @brief Get the ID for a label, adding it if it has not been seen before
+   */
+  static PointId Intern(const std::string& name);
+
+  /**
+   * @brief Look up the ID for a label without adding it
+   * @return false if no animation has ever used this label
+   */
+  static bool Find(const std::string& name, PointId& id);
+
+  /**
+   * @brief Get the upper case label for an ID
+   */
+  static const std::string& GetName(PointId id);
+};
+
+/**
+ * @struct FramePoint
+ * @brief A named point in a frame
+ */
+struct FramePoint {
+  PointId id{};
+  sf::Vector2f value;
+};
+
+using FramePoints = std::vector<FramePoint>; /*!< Frames only have a handful of points, a flat list beats a tree */
 
 /**
  * @struct OverrideFrame
@@ -35,7 +75,7 @@ struct Frame {
   bool applyOrigin{}, flipX{}, flipY{};
   sf::Vector2f origin;
 
-  PointHash points;
+  FramePoints points;
 
   Frame(frame_time_t duration, sf::IntRect subregion, bool applyOrigin, sf::Vector2f origin, bool flipX, bool flipY) :
     duration(duration),
@@ -45,7 +85,7 @@ struct Frame {
     flipX(flipX),
     flipY(flipY)
   {
-    points["ORIGIN"] = origin;
+    points.push_back({ PointNames::ORIGIN, origin });
   }
 
   Frame(const Frame& rhs) {
@@ -75,7 +115,7 @@ struct Frame {
     rhs.applyOrigin = false;
 
     origin = rhs.origin;
-    points = rhs.points;
+    points = std::move(rhs.points);
     rhs.points.clear();
 
     flipX = rhs.flipX;
@@ -87,7 +127,33 @@ struct Frame {
   }
 
   Frame(Frame&& rhs) noexcept {
-    *this = rhs;
+    *this = std::move(rhs);
+  }
+
+  /**
+   * @brief Sets the point with this id, overwriting any existing value
+   */
+  void SetPoint(PointId id, const sf::Vector2f& value) {
+    for (FramePoint& point : points) {
+      if (point.id == id) {
+        point.value = value;
+        return;
+      }
+    }
+
+    points.push_back({ id, value });
+  }
+
+  /**
+   * @brief Find a point by id
+   * @return nullptr if this frame does not have the point
+   */
+  const sf::Vector2f* FindPoint(PointId id) const {
+    for (const FramePoint& point : points) {
+      if (point.id == id) return &point.value;
+    }
+
+    return nullptr;
   }
 };
 
@@ -99,18 +165,82 @@ struct Frame {
  */
 class FrameList {
   std::vector<Frame> frames;
+  std::vector<frame_time_t> startTimes; /*!< startTimes[i] is the sum of durations before frame i, one extra entry holds the total */
   frame_time_t totalDuration; /*!< Sum of all frame durations */
+  uint64_t revision{}; /*!< Changes whenever the frame data changes, lets animators skip refreshing points */
+
+  inline static std::atomic<uint64_t> nextRevision{ 1 };
+
+  void Touch() { revision = nextRevision++; }
+
+  void Push(Frame&& frame) {
+    if (startTimes.empty()) startTimes.push_back(::frames(0));
+    totalDuration += frame.duration;
+    startTimes.push_back(totalDuration);
+    frames.push_back(std::move(frame));
+    Touch();
+  }
+
+  /**
+  * @brief Time from the start of the playback order to the frame at position
+  * @param position in playback order, may be one past the last frame
+  * @param reversed if true, position 0 is the last frame in the list
+  *
+  * The reversed order is read from the same prefix sums so no reversed copy is ever made
+  */
+  frame_time_t GetStartTime(size_t position, bool reversed) const {
+    if (!reversed) return startTimes[position];
+    return totalDuration - startTimes[frames.size() - position];
+  }
+
+  /**
+  * @brief Get the frame at a position in playback order
+  */
+  const Frame& GetFrameAt(size_t position, bool reversed) const {
+    return frames[reversed ? frames.size() - 1u - position : position];
+  }
+
+  /**
+  * @brief Binary search for the frame that `progress` time lands on when playing from the frame at `start`
+  * @return position in playback order. Frames ending exactly on `progress` are landed on.
+  * If `progress` runs past the end, the last position is returned.
+  */
+  size_t FindFrame(size_t start, frame_time_t progress, bool reversed) const {
+    frame_time_t target = GetStartTime(start, reversed) + progress;
+    size_t low = start + 1, high = frames.size();
+
+    // smallest end position whose start time reaches the target
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+
+      if (GetStartTime(mid, reversed) >= target) {
+        high = mid;
+      }
+      else {
+        low = mid + 1;
+      }
+    }
+
+    return low - 1;
+  }
 
 public:
   friend class Animator;
 
-  FrameList() { totalDuration = ::frames(0); }
+  FrameList() { totalDuration = ::frames(0); Touch(); }
   FrameList(const FrameList& rhs) { 
-    frames = rhs.frames; 
+    *this = rhs;
+  }
+
+  FrameList& operator=(const FrameList& rhs) {
+    frames = rhs.frames;
+    startTimes = rhs.startTimes;
     totalDuration = rhs.totalDuration;
+    Touch();
+    return *this;
   }
 
-  FrameList MakeNewFromOverrideData(const std::list<OverrideFrame>& data) {
+  FrameList MakeNewFromOverrideData(const std::list<OverrideFrame>& data) const {
     FrameList res;
     if (frames.empty()) return res;
 
@@ -124,8 +254,7 @@ public:
 
       Frame copy = frames[index];
       copy.duration = from_seconds(iter->duration);
-      res.frames.push_back(copy);
-      res.totalDuration += copy.duration;
+      res.Push(std::move(copy));
 
       iter = std::next(iter);
     }
@@ -139,8 +268,7 @@ public:
    * @param sub int rectangle defining the frame from a texture sheet
    */
   inline void Add(frame_time_t dur, sf::IntRect sub) {
-    frames.emplace_back(std::move(Frame(dur, sub, false, sf::Vector2f(0,0), false, false )));
-    totalDuration += dur;
+    Push(Frame(dur, sub, false, sf::Vector2f(0,0), false, false ));
   }
 
   /**
@@ -152,8 +280,7 @@ public:
    * @param flipY if the frame is flipped vertically   visually (does not affect points)
    */
   inline void Add(frame_time_t dur, sf::IntRect sub, sf::Vector2f origin, bool flipX, bool flipY) {
-    frames.emplace_back(std::move(Frame(dur, sub, true, origin, flipX, flipY)));
-    totalDuration += dur;
+    Push(Frame(dur, sub, true, origin, flipX, flipY));
   }
 
   /**
@@ -164,23 +291,22 @@ public:
   * Will overwrite any other point with the same name in the frame - unique names only
   */
   inline void SetPoint(const std::string& name, int x, int y) {
-    auto str = name;
-    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-    frames[frames.size() - 1].points[name] = sf::Vector2f(float(x), float(y));
+    frames[frames.size() - 1].SetPoint(PointNames::Intern(name), sf::Vector2f(float(x), float(y)));
+    Touch();
   }
 
   /**
  * @brief Get the total number of frames in this list
  * @return const unsigned int
  */
-  inline const size_t GetFrameCount() { return frames.size(); }
+  inline const size_t GetFrameCount() const { return frames.size(); }
 
   /**
   * @brief Get the frame data at the given index
   * @param index of the frame in the list (base 0)
   * @return const Frame immutable
   */
-  inline const Frame& GetFrame(const int index) { return frames[index]; }
+  inline const Frame& GetFrame(const int index) const { return frames[index]; }
 
   /**
    * @brief Get the total duration for the list of frames
@@ -214,7 +340,9 @@ private:
   FrameCallbackHash queuedCallbacks; /*!< used for adding new callbacks while updating */
   FrameCallbackHash queuedOnetimeCallbacks; /*!< adding new one-time callbacks in update */
   
-  PointHash currentPoints;
+  FramePoints currentPoints;
+  uint64_t pointsRevision{}; /*!< FrameList revision currentPoints was read from */
+  int pointsIndex{ -1 }; /*!< Frame index currentPoints was read from */
   
   FrameFinishCallback onFinish; /*!< special callback that fires when the animation is completed */
   FrameFinishCallback queuedOnFinish; /*!< Queues onFinish callback when used in the middle of update */
@@ -287,6 +415,12 @@ public:
    */
   char GetMode();
   
+  const sf::Vector2f GetPoint(PointId id) const;
+  const bool HasPoint(PointId id) const;
+
+  /**
+   * @brief String lookups for scripts, prefer the PointId overloads
+   */
   const sf::Vector2f GetPoint(const std::string& pointName);
   const bool HasPoint(const std::string& pointName);
 
@@ -301,7 +435,7 @@ public:
    * @param target sprite to apply frames to
    * @param sequence list of frames
    */
-  void operator() (frame_time_t progress, sf::Sprite& target, FrameList& sequence);
+  void operator() (frame_time_t progress, sf::Sprite& target, const FrameList& sequence);
   
   /**
    * @brief Applies a callback
@@ -329,7 +463,7 @@ public:
    * @param target sprite to apply frame to
    * @param sequence frame is pulled from list using index
    */
-  void SetFrame(int frameIndex, sf::Sprite& target, FrameList& sequence);
+  void SetFrame(int frameIndex, sf::Sprite& target, const FrameList& sequence);
 
   /**
  * @brief Updates the internal points hash from the frame list for a given frame
@@ -339,5 +473,5 @@ public:
  * Once this function is complete, the currentpoints stored inside the animator
  * is refreshed with latest data
  */
-  void UpdateCurrentPoints(int frameIndex, FrameList& sequence);
+  void UpdateCurrentPoints(int frameIndex, const FrameList& sequence);
 };
@@ -1,7 +1,9 @@
 #include "bnAudioResourceManager.h"
 #include "bnLogger.h"
 
-AudioResourceManager::AudioResourceManager(){
+AudioResourceManager::AudioResourceManager() :
+  cached("Audio", DEFAULT_MEMORY_BUDGET)
+{
   midiMusic.loadSoundFontFromFile("resources/midi/soundfont.sf2");
 
   isEnabled = true;
@@ -129,16 +131,15 @@ void AudioResourceManager::LoadSource(AudioType type, const std::string& path) {
 
 std::shared_ptr<sf::SoundBuffer> AudioResourceManager::LoadFromFile(const std::string& path)
 {
-  auto iter = cached.find(path);
-  std::shared_ptr<sf::SoundBuffer> loaded;
+  std::shared_ptr<sf::SoundBuffer> loaded = cached.Find(path);
 
-  if (iter == cached.end()) {
+  if (!loaded) {
     loaded = std::make_shared<sf::SoundBuffer>();
     loaded->loadFromFile(path);
-    cached.insert(std::make_pair(path, CachedResource<sf::SoundBuffer>(loaded)));
-  }
-  else {
-    loaded = iter->second.GetResource();
+
+    // the sample count already includes every channel
+    size_t bytes = static_cast<size_t>(loaded->getSampleCount()) * sizeof(sf::Int16);
+    loaded = cached.Insert(path, loaded, bytes);
   }
 
   return loaded;
@@ -146,21 +147,12 @@ std::shared_ptr<sf::SoundBuffer> AudioResourceManager::LoadFromFile(const std::s
 
 void AudioResourceManager::HandleExpiredAudioCache()
 {
-  auto iter = cached.begin();
-  while (iter != cached.end()) {
-    if (iter->second.GetSecondsSinceLastRequest() > 60.0f) {
-      if (iter->second.IsInUse()) {
-        iter++; continue;
-      }
-
-      // 1 minute is long enough
-      Logger::Logf(LogLevel::debug, "Audio data %s expired", iter->first.c_str());
-      iter = cached.erase(iter);
-      continue;
-    }
+  cached.HandleExpired();
+}
 
-    iter++;
-  }
+void AudioResourceManager::SetMemoryBudget(size_t bytes)
+{
+  cached.SetBudget(bytes);
 }
 
 int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
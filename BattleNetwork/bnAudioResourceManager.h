@@ -43,6 +43,8 @@ enum class AudioPriority : int {
  */
 class AudioResourceManager {
 public:
+  static constexpr size_t DEFAULT_MEMORY_BUDGET = 64u * 1024u * 1024u;
+
   /**
    * @brief If true, plays Audio(). If false, does not play Audio()
    * @param status
@@ -79,6 +81,12 @@ public:
   
   void HandleExpiredAudioCache();
 
+  /**
+  * @brief Unused sound buffers are evicted oldest first while the cache takes more than this
+  * @param bytes estimated as 2 bytes for every sample of every channel
+  */
+  void SetMemoryBudget(size_t bytes);
+
   /**
    * @brief Play a sound with an Audio() priority
    * @param type Audio() to play
@@ -110,7 +118,7 @@ private:
   std::mutex mutex;
   Channel* channels;
   sf::SoundBuffer* sources;
-  std::map<std::string, CachedResource<sf::SoundBuffer>> cached;
+  ResourceCache<sf::SoundBuffer> cached;
   sf::Music stream;
   std::string currStreamPath;
   float channelVolume{};
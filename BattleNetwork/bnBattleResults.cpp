@@ -41,20 +41,24 @@ BattleResultsWidget::BattleResultsWidget(const BattleResults& results, Mob* mob,
 
   // Get reward based on score
   item = mob->GetRankedReward(score);
-  resultsSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_FRAME));
+  resultsTexture = Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_FRAME);
+  resultsSprite = sf::Sprite(*resultsTexture);
   resultsSprite.setScale(2.f, 2.f);
   resultsSprite.setPosition(-resultsSprite.getTextureRect().width*2.f, 20.f);
 
-  pressA = sf::Sprite(*Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_PRESS_A));
+  pressATexture = Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_PRESS_A);
+  pressA = sf::Sprite(*pressATexture);
   pressA.setScale(2.f, 2.f);
   pressA.setPosition(2.f*42.f, 249.f);
 
-  star = sf::Sprite(*Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_STAR));
+  starTexture = Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_STAR);
+  star = sf::Sprite(*starTexture);
   star.setScale(2.f, 2.f);
 
 
   if (item) {
-    rewardCard = sf::Sprite(*packageManager.FindPackageByID(item->GetUUID()).GetPreviewTexture());
+    rewardCardTexture = packageManager.FindPackageByID(item->GetUUID()).GetPreviewTexture();
+    rewardCard = sf::Sprite(*rewardCardTexture);
 
     rewardCard.setTextureRect(sf::IntRect(0,0,56,48));
 
@@ -67,7 +71,8 @@ BattleResultsWidget::BattleResultsWidget(const BattleResults& results, Mob* mob,
     }
   }
   else {
-    rewardCard = sf::Sprite(*Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_NODATA));
+    rewardCardTexture = Textures().LoadFromFile(TexturePaths::BATTLE_RESULTS_NODATA);
+    rewardCard = sf::Sprite(*rewardCardTexture);
   }
 
   rewardCard.setScale(2.f, 2.f);
@@ -50,6 +50,7 @@ private:
   sf::Sprite rewardCard; /*!< Reward card graphics */
   sf::Sprite pressA; /*!< Press A sprite */
   sf::Sprite star; /*!< Counter stars */
+  std::shared_ptr<sf::Texture> resultsTexture, rewardCardTexture, pressATexture, starTexture;
   Text time; /*!< Formatted time label */
   Text rank; /*!< Battle scored rank */
   Text reward; /*!< Name of reward */
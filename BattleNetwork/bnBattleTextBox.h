@@ -16,7 +16,7 @@ class Question;
 namespace Battle {
   class TextBox : public AnimatedTextBox {
     bool requestedRetreat{}, asking{};
-    sf::Sprite mug;
+    std::shared_ptr<sf::Texture> mug;
     Animation anim;
     Question* question{ nullptr };
   public:
@@ -34,7 +34,7 @@ namespace Battle {
      */
     void DescribeCard(Battle::Card* card);
     void PromptRetreat();
-    void SetSpeaker(const sf::Sprite& mug, const Animation& anim);
+    void SetSpeaker(const std::shared_ptr<sf::Texture>& mug, const Animation& anim);
     void Reset();
 
     const bool RequestedRetreat() const;
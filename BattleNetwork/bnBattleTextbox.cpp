@@ -39,7 +39,7 @@ void Battle::TextBox::PromptRetreat()
   asking = true;
 }
 
-void Battle::TextBox::SetSpeaker(const sf::Sprite& mug, const Animation& anim)
+void Battle::TextBox::SetSpeaker(const std::shared_ptr<sf::Texture>& mug, const Animation& anim)
 {
   this->mug = mug;
   this->anim = anim;
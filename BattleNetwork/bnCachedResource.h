@@ -1,58 +1,170 @@
 #pragma once
 #include "bnCurrentTime.h"
-#include <Swoosh/Timer.h>
+#include "bnLogger.h"
+
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
-/*! \brief Represents a cached resource of type T. It knows how frequently it is used.
+/*! \brief Path keyed cache of shared resources with a memory budget
+*
+* Entries are kept in least recently used order with an intrusive list.
+* An entry is unreferenced when the cache holds the only shared pointer to it.
+* Unreferenced entries are evicted oldest first while the cache is over budget,
+* and any unreferenced entry that was not requested for a minute is evicted regardless.
+* Entries still referenced elsewhere are never evicted.
 */
 template<typename T>
-class CachedResource {
-  long long lastRequestTime{}; //!< Used to determine if we should remove this resource
-  unsigned int relevanceCount{}; //!< Higher count means this is important
-  bool permanent{}; //!< Never delete resource when timer is up
-  using SharedPtrType = std::shared_ptr<std::remove_pointer_t<T>>;
-  SharedPtrType resource; //!< shared ptr to the actual resource
+class ResourceCache {
 public:
+  using SharedPtrType = std::shared_ptr<T>;
+
+  /**
+  * @param name used in log messages
+  * @param budget total bytes the cache may hold before the oldest unreferenced entries are evicted
+  */
+  ResourceCache(const char* name, size_t budget) : name(name), budget(budget) {}
 
-  /*! \brief Constructor creates a shared resouce, pauses the timer, and sets count to 0*/
-  CachedResource(const T& item, bool perm = false) : 
-    resource(std::make_shared(item)),
-    permanent(perm)
-  {
-    lastRequestTime = CurrentTime::AsMilli();
-    relevanceCount = 0;
+  ResourceCache(const ResourceCache&) = delete;
+
+  void SetBudget(size_t bytes) {
+    std::scoped_lock lock(mutex);
+    budget = bytes;
   }
 
-  CachedResource(SharedPtrType ref, bool perm = false) : 
-    resource(ref),
-    permanent(perm)
-  {
-    lastRequestTime = CurrentTime::AsMilli();
-    relevanceCount = 0;
+  size_t GetBudget() const {
+    std::scoped_lock lock(mutex);
+    return budget;
   }
 
-  /*! \brief returns get() counter*/
-  const unsigned int GetRelevanceCount() const {
-    return relevanceCount;
+  /*! \brief total size of every entry, referenced or not */
+  size_t GetTotalBytes() const {
+    std::scoped_lock lock(mutex);
+    return totalBytes;
   }
 
-  /*! \brief checks if this resource is still in use*/
-  const bool IsInUse() const {
-    return resource.use_count() >= 1 || permanent;
+  /*! \brief returns the resource for key or nullptr and marks it as the most recently used */
+  SharedPtrType Find(const std::string& key) {
+    std::scoped_lock lock(mutex);
+
+    auto iter = entries.find(key);
+
+    if (iter == entries.end()) {
+      return nullptr;
+    }
+
+    Entry& entry = iter->second;
+    entry.lastRequestTime = CurrentTime::AsMilli();
+    Unlink(entry);
+    PushFront(entry);
+
+    return entry.resource;
   }
 
-  /*! \brief returns the resource
-    This function also increases the use count and resets
-    the "last requested" timer.
-  */
-  SharedPtrType GetResource() {
-    relevanceCount++;
-    lastRequestTime = CurrentTime::AsMilli();
-    return resource;
+  /*! \brief adds a resource, if another thread added key first the existing resource is returned */
+  SharedPtrType Insert(const std::string& key, const SharedPtrType& resource, size_t bytes, bool permanent = false) {
+    std::scoped_lock lock(mutex);
+
+    auto [iter, inserted] = entries.try_emplace(key);
+    Entry& entry = iter->second;
+
+    if (inserted) {
+      entry.key = &iter->first;
+      entry.resource = resource;
+      entry.bytes = bytes;
+      entry.permanent = permanent;
+      totalBytes += bytes;
+    }
+    else {
+      Unlink(entry);
+    }
+
+    entry.lastRequestTime = CurrentTime::AsMilli();
+    PushFront(entry);
+
+    return entry.resource;
+  }
+
+  /*! \brief evicts unreferenced entries, cheap enough to call every frame */
+  void HandleExpired() {
+    std::scoped_lock lock(mutex);
+
+    long long now = CurrentTime::AsMilli();
+    bool overBudget = totalBytes > budget;
+
+    // idle entries can wait, only look for them once a second
+    bool sweepIdle = now - lastSweepTime >= SWEEP_INTERVAL_MS;
+
+    if (!overBudget && !sweepIdle) return;
+
+    if (sweepIdle) {
+      lastSweepTime = now;
+    }
+
+    Entry* entry = tail;
+
+    while (entry) {
+      Entry* prev = entry->prev;
+      bool idle = now - entry->lastRequestTime > IDLE_TIME_MS;
+
+      if (!overBudget && !idle) {
+        // everything newer was requested more recently
+        break;
+      }
+
+      if (entry->resource.use_count() == 1 && !entry->permanent) {
+        Logger::Logf(LogLevel::debug, "%s data %s expired", name, entry->key->c_str());
+        totalBytes -= entry->bytes;
+        Unlink(*entry);
+        entries.erase(entries.find(*entry->key));
+        overBudget = totalBytes > budget;
+      }
+
+      entry = prev;
+    }
   }
 
-  /*! \brief return the seconds since this item was last requested */
-  const float GetSecondsSinceLastRequest() {
-    return (CurrentTime::AsMilli() - lastRequestTime)/1000.0f;
+private:
+  struct Entry {
+    const std::string* key{ nullptr }; //!< points into the map node which never moves
+    SharedPtrType resource;
+    size_t bytes{};
+    long long lastRequestTime{};
+    bool permanent{}; //!< Never delete resource
+    Entry* prev{ nullptr }; //!< more recently used
+    Entry* next{ nullptr }; //!< less recently used
+  };
+
+  static constexpr long long IDLE_TIME_MS = 60000; //!< 1 minute is long enough
+  static constexpr long long SWEEP_INTERVAL_MS = 1000;
+
+  void Unlink(Entry& entry) {
+    if (entry.prev) entry.prev->next = entry.next;
+    else if (head == &entry) head = entry.next;
+
+    if (entry.next) entry.next->prev = entry.prev;
+    else if (tail == &entry) tail = entry.prev;
+
+    entry.prev = entry.next = nullptr;
+  }
+
+  void PushFront(Entry& entry) {
+    entry.next = head;
+
+    if (head) head->prev = &entry;
+
+    head = &entry;
+
+    if (!tail) tail = &entry;
   }
+
+  const char* name;
+  mutable std::mutex mutex;
+  size_t budget{};
+  size_t totalBytes{};
+  long long lastSweepTime{};
+  std::unordered_map<std::string, Entry> entries;
+  Entry* head{ nullptr }; //!< most recently used
+  Entry* tail{ nullptr }; //!< least recently used
 };
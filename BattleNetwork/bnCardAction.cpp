@@ -113,7 +113,7 @@ sf::Vector2f CardAction::CalculatePointOffset(const std::string& point) {
     }
   }
 
-  return anim->GetPoint(point) - anim->GetPoint("origin");
+  return anim->GetPoint(point) - anim->GetPoint(PointNames::ORIGIN);
 }
 
 void CardAction::RecallPreviousState()
@@ -295,7 +295,7 @@ void CardAction::Update(double _elapsed)
     node.Update(_elapsed);
 
     // update the node's position
-    sf::Vector2f baseOffset = node.GetParentAnim().GetPoint(nodeName);
+    sf::Vector2f baseOffset = node.GetParentAnim().GetPoint(node.pointId);
     const sf::Vector2f& origin = actor->getSprite().getOrigin();
     baseOffset = baseOffset - origin;
 
@@ -391,7 +391,7 @@ std::optional<bool> CardAction::CanMoveTo(Battle::Tile* next) {
 //////////////////////////////////////////////////
 
 CardAction::Attachment::Attachment(Animation& parentAnim, const std::string& point) :
-  spriteProxy(std::make_shared<SpriteProxyNode>()), parentAnim(parentAnim), point(point)
+  spriteProxy(std::make_shared<SpriteProxyNode>()), parentAnim(parentAnim), point(point), pointId(PointNames::Intern(point))
 {
 }
 
@@ -408,7 +408,7 @@ void CardAction::Attachment::Update(double elapsed)
     node.Update(elapsed);
 
     // update the node's position
-    sf::Vector2f baseOffset = node.GetParentAnim().GetPoint(nodeName);
+    sf::Vector2f baseOffset = node.GetParentAnim().GetPoint(node.pointId);
     const sf::Vector2f& origin = spriteProxy->getSprite().getOrigin();
     baseOffset = baseOffset - origin;
 
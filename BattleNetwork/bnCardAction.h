@@ -46,6 +46,7 @@ public:
 
     bool started{ false };
     std::string point;
+    PointId pointId{}; /*!< Interned point, avoids string lookups every frame */
     std::shared_ptr<SpriteProxyNode> spriteProxy;
     std::reference_wrapper<Animation> parentAnim;
     Attachments attachments;
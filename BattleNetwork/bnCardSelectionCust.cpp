@@ -36,19 +36,23 @@ CardSelectionCust::CardSelectionCust(CardSelectionCust::Props _props) :
   emblem.setScale(2.f, 2.f);
   emblem.setPosition(194.0f, 14.0f);
 
-  custSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_MENU));
+  custTexture = Textures().LoadFromFile(TexturePaths::CHIP_SELECT_MENU);
+  custSprite = sf::Sprite(*custTexture);
   custSprite.setScale(2.f, 2.f);
   custSprite.setPosition(-custSprite.getTextureRect().width*2.f, 0);
 
-  custDarkCardOverlay = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_DARK_OVERLAY));
+  custDarkCardOverlayTexture = Textures().LoadFromFile(TexturePaths::CHIP_SELECT_DARK_OVERLAY);
+  custDarkCardOverlay = sf::Sprite(*custDarkCardOverlayTexture);
   custDarkCardOverlay.setScale(2.f, 2.f);
   custDarkCardOverlay.setPosition(custSprite.getPosition());
 
   custMegaCardOverlay = custDarkCardOverlay;
-  custMegaCardOverlay.setTexture(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_MEGA_OVERLAY));
+  custMegaCardOverlayTexture = Textures().LoadFromFile(TexturePaths::CHIP_SELECT_MEGA_OVERLAY);
+  custMegaCardOverlay.setTexture(*custMegaCardOverlayTexture);
 
   custGigaCardOverlay = custDarkCardOverlay;
-  custGigaCardOverlay.setTexture(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_GIGA_OVERLAY));
+  custGigaCardOverlayTexture = Textures().LoadFromFile(TexturePaths::CHIP_SELECT_GIGA_OVERLAY);
+  custGigaCardOverlay.setTexture(*custGigaCardOverlayTexture);
 
   // TODO: fully use scene nodes on all card slots and the GUI sprite
   // AddSprite(custSprite);
@@ -66,16 +70,19 @@ CardSelectionCust::CardSelectionCust(CardSelectionCust::Props _props) :
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
-  cursorSmall = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_CURSOR_SMALL));
+  cursorSmallTexture = Textures().LoadFromFile(TexturePaths::CHIP_CURSOR_SMALL);
+  cursorSmall = sf::Sprite(*cursorSmallTexture);
   cursorSmall.setScale(sf::Vector2f(2.f, 2.f));
 
-  cursorBig = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_CURSOR_BIG));
+  cursorBigTexture = Textures().LoadFromFile(TexturePaths::CHIP_CURSOR_BIG);
+  cursorBig = sf::Sprite(*cursorBigTexture);
   cursorBig.setScale(sf::Vector2f(2.f, 2.f));
 
   // never moves
   cursorBig.setPosition(sf::Vector2f(2.f*104.f, 2.f*122.f));
 
-  cardLock = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_LOCK));
+  cardLockTexture = Textures().LoadFromFile(TexturePaths::CHIP_LOCK);
+  cardLock = sf::Sprite(*cardLockTexture);
   cardLock.setScale(sf::Vector2f(2.f, 2.f));
 
   cardCard.setScale(2.f, 2.f);
@@ -117,7 +124,8 @@ CardSelectionCust::CardSelectionCust(CardSelectionCust::Props _props) :
 
   formSelectQuitTimer = 0.f; // used to time out the activation
 
-  formItemBG.setTexture(*Textures().LoadFromFile(TexturePaths::CUST_FORM_ITEM_BG));
+  formItemBGTexture = Textures().LoadFromFile(TexturePaths::CUST_FORM_ITEM_BG);
+  formItemBG.setTexture(*formItemBGTexture);
   formItemBG.setScale(2.f, 2.f);
 
   formSelect.setTexture(Textures().LoadFromFile(TexturePaths::CUST_FORM_SELECT));
@@ -451,7 +459,7 @@ bool CardSelectionCust::CloseTextBox() {
   return true;
 }
 
-void CardSelectionCust::SetSpeaker(const sf::Sprite& mug, const Animation& anim)
+void CardSelectionCust::SetSpeaker(const std::shared_ptr<sf::Texture>& mug, const Animation& anim)
 {
   textbox.SetSpeaker(mug, anim);
 }
@@ -521,7 +529,9 @@ void CardSelectionCust::SetPlayerFormOptions(const std::vector<PlayerFormMeta*>
   for (PlayerFormMeta* f : forms) {
     this->forms.push_back(f);
     sf::Sprite ui;
-    ui.setTexture(*Textures().LoadFromFile(f->GetUIPath()));
+    std::shared_ptr<sf::Texture> texture = Textures().LoadFromFile(f->GetUIPath());
+    ui.setTexture(*texture);
+    formUITextures.push_back(texture);
     ui.setScale(2.f, 2.f);
     formUI.push_back(ui);
   }
@@ -76,6 +76,8 @@ private:
   mutable SpriteProxyNode formSelect;
   mutable SpriteProxyNode formCursor;
   std::shared_ptr<sf::Texture> noIcon, noCard; // used when missing card data
+  std::shared_ptr<sf::Texture> custTexture, custDarkCardOverlayTexture, custMegaCardOverlayTexture, custGigaCardOverlayTexture;
+  std::shared_ptr<sf::Texture> cursorSmallTexture, cursorBigTexture, cardLockTexture, formItemBGTexture;
   sf::Shader* greyscale;
   Font labelFont;
   Font codeFont, codeFont2;
@@ -103,6 +105,7 @@ private:
   float darkCardShadowAlpha;
   bool retreatAllowed{true};
   std::vector<sf::Sprite> formUI;
+  std::vector<std::shared_ptr<sf::Texture>> formUITextures; //!< kept after a form is erased, the selected form item may still draw it
   double formSelectQuitTimer;
   double frameElapsed; /*!< delta seconds since last frame */
   std::vector<Battle::Card> selectedCards; /*!< Pointer to a list of selected cards */
@@ -158,7 +161,7 @@ public:
    */
   bool CloseTextBox();
 
-  void SetSpeaker(const sf::Sprite& mug, const Animation& anim);
+  void SetSpeaker(const std::shared_ptr<sf::Texture>& mug, const Animation& anim);
   void PromptRetreat();
   
   /**
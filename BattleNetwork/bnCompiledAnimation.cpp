@@ -0,0 +1,465 @@
+#include "bnCompiledAnimation.h"
+#include "bnFileUtil.h"
+#include "bnLogger.h"
+#include "crypto/xxhash64.h"
+
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+// TODO: mac os < 10.5 file system support...
+#ifndef __APPLE__
+#include <filesystem>
+#endif
+
+namespace {
+  constexpr uint32_t MAGIC = 0x41424E4F; // "ONBA" read as little endian
+  constexpr uint32_t VERSION = 1;
+
+  enum FrameFlags : uint8_t {
+    applyOrigin = 1 << 0,
+    flipX = 1 << 1,
+    flipY = 1 << 2
+  };
+
+  std::mutex cacheDirMutex;
+  std::string cacheDir;
+
+  /*! \brief Appends fixed width values in little endian order */
+  class Writer {
+    std::string& out;
+  public:
+    Writer(std::string& out) : out(out) {}
+
+    void U8(uint8_t v) { out.push_back(static_cast<char>(v)); }
+
+    void U32(uint32_t v) {
+      for (int i = 0; i < 4; i++) U8(static_cast<uint8_t>(v >> (i * 8)));
+    }
+
+    void U64(uint64_t v) {
+      for (int i = 0; i < 8; i++) U8(static_cast<uint8_t>(v >> (i * 8)));
+    }
+
+    void I32(int32_t v) { U32(static_cast<uint32_t>(v)); }
+    void I64(int64_t v) { U64(static_cast<uint64_t>(v)); }
+
+    void F32(float v) {
+      uint32_t bits;
+      std::memcpy(&bits, &v, sizeof(bits));
+      U32(bits);
+    }
+
+    void String(const std::string& str) {
+      U32(static_cast<uint32_t>(str.size()));
+      out.append(str);
+    }
+  };
+
+  /*! \brief Reads values written by Writer, ok() turns false on truncated data */
+  class Reader {
+    const std::string& in;
+    size_t pos{};
+    bool good{ true };
+  public:
+    Reader(const std::string& in) : in(in) {}
+
+    bool ok() const { return good; }
+
+    uint8_t U8() {
+      if (pos >= in.size()) {
+        good = false;
+        return 0;
+      }
+
+      return static_cast<uint8_t>(in[pos++]);
+    }
+
+    uint32_t U32() {
+      uint32_t v{};
+      for (int i = 0; i < 4; i++) v |= static_cast<uint32_t>(U8()) << (i * 8);
+      return v;
+    }
+
+    uint64_t U64() {
+      uint64_t v{};
+      for (int i = 0; i < 8; i++) v |= static_cast<uint64_t>(U8()) << (i * 8);
+      return v;
+    }
+
+    int32_t I32() { return static_cast<int32_t>(U32()); }
+    int64_t I64() { return static_cast<int64_t>(U64()); }
+
+    float F32() {
+      uint32_t bits = U32();
+      float v;
+      std::memcpy(&v, &bits, sizeof(v));
+      return v;
+    }
+
+    /**
+    * @brief Reads an element count, rejects counts that could not fit in the remaining data
+    */
+    uint32_t Count(size_t minElementSize) {
+      uint32_t count = U32();
+
+      if (!good || count > (in.size() - pos) / minElementSize) {
+        good = false;
+        return 0;
+      }
+
+      return count;
+    }
+
+    std::string String() {
+      uint32_t len = U32();
+
+      if (!good || len > in.size() - pos) {
+        good = false;
+        return {};
+      }
+
+      std::string str = in.substr(pos, len);
+      pos += len;
+      return str;
+    }
+  };
+
+  /*! \brief Binaries remember the hash of the source they were compiled from, copies and checkouts do not keep modified times */
+  uint64_t HashSource(const std::string& source) {
+    XXH64State state;
+    XXH64Init(&state, 0);
+    XXH64Update(&state, source.data(), source.size());
+    return XXH64Digest(&state);
+  }
+
+  std::string GetCachePath(const std::string& sourcePath) {
+    std::scoped_lock lock(cacheDirMutex);
+
+    if (cacheDir.empty()) return {};
+
+#ifndef __APPLE__
+    std::filesystem::path normalized = std::filesystem::path(sourcePath).lexically_normal();
+    std::string key = normalized.generic_string();
+    std::string fileName = normalized.filename().string();
+#else
+    std::string key = sourcePath;
+    std::string fileName = sourcePath.substr(sourcePath.find_last_of("/\\") + 1);
+#endif
+
+    // different paths can share a file name, the hash of the whole path keeps them apart
+    XXH64State state;
+    XXH64Init(&state, 0);
+    XXH64Update(&state, key.data(), key.size());
+
+    std::stringstream name;
+    name << fileName << "-" << std::hex << XXH64Digest(&state);
+
+    return cacheDir + "/" + name.str() + CompiledAnimation::EXTENSION;
+  }
+
+  std::string Serialize(const Animation::StateMap& states, uint64_t sourceHash) {
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    auto intern = [&strings, &stringIds](const std::string& str) {
+      auto [iter, inserted] = stringIds.try_emplace(str, static_cast<uint32_t>(strings.size()));
+
+      if (inserted) {
+        strings.push_back(str);
+      }
+
+      return iter->second;
+    };
+
+    std::string stateBlock, frameBlock, pointBlock;
+    Writer stateOut(stateBlock), frameOut(frameBlock), pointOut(pointBlock);
+    uint32_t frameCount{}, pointCount{};
+
+    for (auto& [name, list] : states) {
+      stateOut.U32(intern(name));
+      stateOut.U32(frameCount);
+      stateOut.U32(static_cast<uint32_t>(list.GetFrameCount()));
+
+      for (size_t i = 0; i < list.GetFrameCount(); i++) {
+        const Frame& frame = list.GetFrame(static_cast<int>(i));
+
+        uint8_t flags = 0;
+        if (frame.applyOrigin) flags |= FrameFlags::applyOrigin;
+        if (frame.flipX) flags |= FrameFlags::flipX;
+        if (frame.flipY) flags |= FrameFlags::flipY;
+
+        frameOut.I64(frame.duration.count());
+        frameOut.I32(frame.subregion.left);
+        frameOut.I32(frame.subregion.top);
+        frameOut.I32(frame.subregion.width);
+        frameOut.I32(frame.subregion.height);
+        frameOut.F32(frame.origin.x);
+        frameOut.F32(frame.origin.y);
+        frameOut.U8(flags);
+        frameOut.U32(pointCount);
+        frameOut.U32(static_cast<uint32_t>(frame.points.size()));
+
+        for (const FramePoint& point : frame.points) {
+          pointOut.U32(intern(PointNames::GetName(point.id)));
+          pointOut.F32(point.value.x);
+          pointOut.F32(point.value.y);
+          pointCount++;
+        }
+
+        frameCount++;
+      }
+    }
+
+    std::string data;
+    Writer out(data);
+    out.U32(MAGIC);
+    out.U32(VERSION);
+    out.U64(sourceHash);
+
+    out.U32(static_cast<uint32_t>(strings.size()));
+    for (auto& str : strings) {
+      out.String(str);
+    }
+
+    out.U32(static_cast<uint32_t>(states.size()));
+    data += stateBlock;
+    out.U32(frameCount);
+    data += frameBlock;
+    out.U32(pointCount);
+    data += pointBlock;
+
+    return data;
+  }
+
+  std::shared_ptr<Animation::StateMap> Deserialize(const std::string& data, uint64_t sourceHash) {
+    Reader in(data);
+
+    if (in.U32() != MAGIC || in.U32() != VERSION) return nullptr;
+
+    if (in.U64() != sourceHash || !in.ok()) {
+      // source changed since this was compiled
+      return nullptr;
+    }
+
+    std::vector<std::string> strings(in.Count(4));
+    for (auto& str : strings) {
+      str = in.String();
+    }
+
+    struct StateRecord {
+      uint32_t name, firstFrame, frameCount;
+    };
+
+    std::vector<StateRecord> stateRecords(in.Count(12));
+    for (auto& record : stateRecords) {
+      record.name = in.U32();
+      record.firstFrame = in.U32();
+      record.frameCount = in.U32();
+    }
+
+    struct FrameRecord {
+      int64_t duration;
+      sf::IntRect rect;
+      sf::Vector2f origin;
+      uint8_t flags;
+      uint32_t firstPoint, pointCount;
+    };
+
+    std::vector<FrameRecord> frameRecords(in.Count(41));
+    for (auto& record : frameRecords) {
+      record.duration = in.I64();
+      record.rect.left = in.I32();
+      record.rect.top = in.I32();
+      record.rect.width = in.I32();
+      record.rect.height = in.I32();
+      record.origin.x = in.F32();
+      record.origin.y = in.F32();
+      record.flags = in.U8();
+      record.firstPoint = in.U32();
+      record.pointCount = in.U32();
+    }
+
+    struct PointRecord {
+      uint32_t name;
+      float x, y;
+    };
+
+    std::vector<PointRecord> pointRecords(in.Count(12));
+    for (auto& record : pointRecords) {
+      record.name = in.U32();
+      record.x = in.F32();
+      record.y = in.F32();
+    }
+
+    if (!in.ok()) return nullptr;
+
+    auto states = std::make_shared<Animation::StateMap>();
+
+    for (auto& state : stateRecords) {
+      if (state.name >= strings.size() || size_t(state.firstFrame) + state.frameCount > frameRecords.size()) return nullptr;
+
+      FrameList& list = (*states)[strings[state.name]];
+
+      for (uint32_t i = state.firstFrame; i < state.firstFrame + state.frameCount; i++) {
+        const FrameRecord& frame = frameRecords[i];
+
+        if (size_t(frame.firstPoint) + frame.pointCount > pointRecords.size()) return nullptr;
+
+        if (frame.flags & FrameFlags::applyOrigin) {
+          list.Add(frames(frame.duration), frame.rect, frame.origin, frame.flags & FrameFlags::flipX, frame.flags & FrameFlags::flipY);
+        }
+        else {
+          list.Add(frames(frame.duration), frame.rect);
+        }
+
+        for (uint32_t j = frame.firstPoint; j < frame.firstPoint + frame.pointCount; j++) {
+          const PointRecord& point = pointRecords[j];
+
+          if (point.name >= strings.size()) return nullptr;
+
+          list.SetPoint(strings[point.name], static_cast<int>(point.x), static_cast<int>(point.y));
+        }
+      }
+    }
+
+    return states;
+  }
+
+  std::shared_ptr<Animation::StateMap> ReadBinary(const std::string& binaryPath, uint64_t sourceHash) {
+    std::ifstream file(binaryPath, std::ios::binary);
+
+    if (!file) return nullptr;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    return Deserialize(buffer.str(), sourceHash);
+  }
+
+  bool WriteBinary(const std::string& binaryPath, const std::string& data) {
+#ifndef __APPLE__
+    // write beside the final file and swap it in so readers never see a partial binary
+    std::string tempPath = binaryPath + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    {
+      std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+      if (!file) return false;
+
+      file.write(data.data(), data.size());
+
+      if (!file) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, binaryPath, ec);
+
+    if (ec) {
+      std::filesystem::remove(tempPath, ec);
+      return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+  }
+}
+
+void CompiledAnimation::SetCacheDirectory(const std::string& dir)
+{
+  std::scoped_lock lock(cacheDirMutex);
+  cacheDir = dir;
+
+#ifndef __APPLE__
+  if (!cacheDir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+
+    if (ec) {
+      Logger::Logf(LogLevel::warning, "Could not create animation cache directory %s", cacheDir.c_str());
+      cacheDir.clear();
+    }
+  }
+#endif
+}
+
+std::shared_ptr<Animation::StateMap> CompiledAnimation::Load(const std::string& sourcePath, const std::string& source)
+{
+  if (source.empty()) return nullptr;
+
+  uint64_t sourceHash = HashSource(source);
+
+  if (auto states = ReadBinary(sourcePath + EXTENSION, sourceHash)) {
+    return states;
+  }
+
+  std::string cachePath = GetCachePath(sourcePath);
+
+  if (cachePath.empty()) return nullptr;
+
+  return ReadBinary(cachePath, sourceHash);
+}
+
+void CompiledAnimation::Save(const std::string& sourcePath, const std::string& source, const Animation::StateMap& states)
+{
+  if (source.empty()) return;
+
+  std::string cachePath = GetCachePath(sourcePath);
+
+  if (cachePath.empty()) return;
+
+  if (!WriteBinary(cachePath, Serialize(states, HashSource(source)))) {
+    Logger::Logf(LogLevel::debug, "Could not cache compiled animation %s", cachePath.c_str());
+  }
+}
+
+bool CompiledAnimation::CompileNextToSource(const std::string& sourcePath)
+{
+  std::string source = FileUtil::Read(sourcePath);
+
+  if (source.empty()) {
+    Logger::Logf(LogLevel::critical, "Could not read animation file %s", sourcePath.c_str());
+    return false;
+  }
+
+  auto states = Animation::ParseStates(source, sourcePath);
+  std::string binaryPath = sourcePath + EXTENSION;
+
+  if (!WriteBinary(binaryPath, Serialize(*states, HashSource(source)))) {
+    Logger::Logf(LogLevel::critical, "Could not write compiled animation %s", binaryPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+size_t CompiledAnimation::CompileDirectory(const std::string& dir)
+{
+  size_t count{};
+
+#ifndef __APPLE__
+  std::error_code ec;
+
+  for (auto& entry : std::filesystem::recursive_directory_iterator(dir, ec)) {
+    if (!entry.is_regular_file() || entry.path().extension() != ANIMATION_EXTENSION) continue;
+
+    std::string sourcePath = entry.path().generic_string();
+
+    if (CompileNextToSource(sourcePath)) {
+      Logger::Logf(LogLevel::info, "Compiled %s", sourcePath.c_str());
+      count++;
+    }
+  }
+
+  if (ec) {
+    Logger::Logf(LogLevel::critical, "Could not read directory %s", dir.c_str());
+  }
+#endif
+
+  return count;
+}
@@ -0,0 +1,60 @@
+/*! \file bnCompiledAnimation.h */
+
+/*! \brief Binary companion format for .animation files
+ *
+ * Parsing the text format is the bulk of the work when booting with many packages.
+ * Parsed states are written out once as a compact binary and read back on later loads:
+ *
+ * ```
+ * header  : magic "ONBA", version, XXH64 hash of the source file
+ * strings : every state and point name, stored once
+ * states  : name index, first frame, frame count
+ * frames  : fixed size records (duration, rect, origin, flags, first point, point count)
+ * points  : name index, x, y
+ * ```
+ *
+ * The binary is only used while the hash of the source file matches, so binaries survive
+ * copies, zip extraction and checkouts that do not keep modified times.
+ * A binary next to the source file (foo.animation.bin) is preferred, otherwise binaries
+ * are kept in the cache directory, named after the source file and a hash of its path.
+ */
+
+#pragma once
+#include "bnAnimation.h"
+
+#include <memory>
+#include <string>
+
+namespace CompiledAnimation {
+  constexpr const char* EXTENSION = ".bin";
+
+  /**
+  * @brief Set the directory binaries are written to when compiling on first load
+  * @param dir if empty, binaries are only read from next to the source file
+  */
+  void SetCacheDirectory(const std::string& dir);
+
+  /**
+  * @brief Loads the binary for the animation file at sourcePath
+  * @param source contents of the file at sourcePath
+  * @return nullptr if there is no binary or it was compiled from other source
+  */
+  std::shared_ptr<Animation::StateMap> Load(const std::string& sourcePath, const std::string& source);
+
+  /**
+  * @brief Writes states parsed from source, the contents of sourcePath, to the cache directory
+  */
+  void Save(const std::string& sourcePath, const std::string& source, const Animation::StateMap& states);
+
+  /**
+  * @brief Compiles the animation file at sourcePath to a binary next to it
+  * @return false if the source could not be read or the binary could not be written
+  */
+  bool CompileNextToSource(const std::string& sourcePath);
+
+  /**
+  * @brief Compiles every .animation file under dir
+  * @return number of files compiled
+  */
+  size_t CompileDirectory(const std::string& dir);
+}
@@ -205,7 +205,8 @@ ConfigScene::ConfigScene(swoosh::ActivityController& controller) :
   endBtnAnimator.Load();
 
   // end button
-  endBtn = sf::Sprite(*Textures().LoadFromFile(TexturePaths::END_BTN));;
+  endBtnTexture = Textures().LoadFromFile(TexturePaths::END_BTN);
+  endBtn = sf::Sprite(*endBtnTexture);
   endBtn.setScale(2.f, 2.f);
   endBtnAnimator.SetAnimation("BLINK");
   endBtnAnimator.SetFrame(1, endBtn);
@@ -37,6 +37,7 @@ private:
   // ui sprite maps
   Animation endBtnAnimator;
   sf::Sprite endBtn;
+  std::shared_ptr<sf::Texture> endBtnTexture;
   Background* bg{ nullptr };
 
   class MenuItem : public SceneNode {
@@ -12,8 +12,10 @@ CustEmblem::CustEmblem() {
     wireShader->setUniform("numOfWires", numWires);
   }
 
-  emblem.setTexture(*handle.Textures().LoadFromFile(TexturePaths::CUST_BADGE));
-  emblemWireMask.setTexture(*handle.Textures().LoadFromFile(TexturePaths::CUST_BADGE_MASK));
+  emblemTexture = handle.Textures().LoadFromFile(TexturePaths::CUST_BADGE);
+  emblem.setTexture(*emblemTexture);
+  emblemWireMaskTexture = handle.Textures().LoadFromFile(TexturePaths::CUST_BADGE_MASK);
+  emblemWireMask.setTexture(*emblemWireMaskTexture);
 
   emblemWireMask.setPosition(-9.0f, -7.0f);
 }
@@ -15,6 +15,7 @@ class CustEmblem : public sf::Drawable, public sf::Transformable {
 private:
   sf::Sprite emblem; /*!< The emblem drawn in place */
   sf::Sprite emblemWireMask; /*!< The pixel color mask for electricity paths */
+  std::shared_ptr<sf::Texture> emblemTexture, emblemWireMaskTexture;
 
   mutable sf::Shader* wireShader; /*!< The shader that uses the mask and progress values */
 
@@ -534,14 +534,14 @@ void Entity::RefreshShader()
 
   bool iframes = invincibilityCooldown > frames(0);
   bool whiteout = hit && !isTimeFrozen;
-  vector<float> states = {
+  float states[] = {
     static_cast<float>(whiteout),                                           // WHITEOUT
     static_cast<float>(rootCooldown > frames(0) && (iframes || rootFrame)), // BLACKOUT
     static_cast<float>(stunCooldown > frames(0) && (iframes || stunFrame)), // HIGHLIGHT
     static_cast<float>(freezeCooldown > frames(0))                          // ICEOUT
   };
 
-  smartShader.SetUniform("states", states);
+  smartShader.SetUniform("states", states, std::size(states));
   smartShader.SetUniform("additiveMode", GetColorMode() == ColorMode::additive);
 
   bool enabled = states[0] || states[1];
@@ -569,76 +569,78 @@ void Entity::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
   states.transform *= combinedTransform;
 
-  std::vector<SceneNode*> copies;
-  copies.reserve(childNodes.size() + 1);
+  SortChildNodes();
 
-  for (std::shared_ptr<SceneNode>& child : childNodes) {
-    copies.push_back(child.get());
-  }
+  auto drawSelf = [&] {
+    sf::Shader* s = smartShader.Get();
 
-  copies.push_back((SceneNode*)this);
+    if (s) {
+      states.shader = s;
+    }
+
+    target.draw(getSpriteConst(), states);
+  };
 
-  std::sort(copies.begin(), copies.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+  // children on our layer or above are drawn behind us
+  bool drawnSelf = false;
 
   // draw its children
-  for (std::size_t i = 0; i < copies.size(); i++) {
-    SceneNode* currNode = copies[i];
+  for (std::shared_ptr<SceneNode>& child : childNodes) {
+    SceneNode* currNode = child.get();
 
     if (!currNode) continue;
 
     // If it's time to draw our scene node, we draw the proxy sprite
-    if (currNode == this) {
-      sf::Shader* s = smartShader.Get();
-
-      if (s) {
-        states.shader = s;
-      }
-
-      target.draw(getSpriteConst(), states);
+    if (!drawnSelf && currNode->GetLayer() < GetLayer()) {
+      drawSelf();
+      drawnSelf = true;
     }
-    else {
-      SpriteProxyNode* asSpriteProxyNode{ nullptr };
-      SmartShader temp(smartShader);
 
-      /**
-      hack for now.
-      form overlay nodes (like helmet and shoulder pads)
-      are already colored to the desired palette. So we do not apply palette swapping.
-      **/
-      bool needsRevert = false;
-      sf::Color tempColor = sf::Color::White;
-      if (currNode->HasTag(Player::FORM_NODE_TAG)) {
-        asSpriteProxyNode = dynamic_cast<SpriteProxyNode*>(currNode);
-
-        if (asSpriteProxyNode) {
-          smartShader.SetUniform("swapPalette", false);
-          tempColor = asSpriteProxyNode->getColor();
-          asSpriteProxyNode->setColor(sf::Color(0, 0, 0, getColor().a));
-          needsRevert = true;
-        }
+    SpriteProxyNode* asSpriteProxyNode{ nullptr };
+    smartShader.PushState();
+
+    /**
+    hack for now.
+    form overlay nodes (like helmet and shoulder pads)
+    are already colored to the desired palette. So we do not apply palette swapping.
+    **/
+    bool needsRevert = false;
+    sf::Color tempColor = sf::Color::White;
+    if (currNode->HasTag(Player::FORM_NODE_TAG)) {
+      asSpriteProxyNode = dynamic_cast<SpriteProxyNode*>(currNode);
+
+      if (asSpriteProxyNode) {
+        smartShader.SetUniform("swapPalette", false);
+        tempColor = asSpriteProxyNode->getColor();
+        asSpriteProxyNode->setColor(sf::Color(0, 0, 0, getColor().a));
+        needsRevert = true;
       }
+    }
 
-      // Apply and return shader if applicable
-      sf::Shader* s = smartShader.Get();
+    // Apply and return shader if applicable
+    sf::Shader* s = smartShader.Get();
 
-      if (s && currNode->IsUsingParentShader()) {
-        if (auto asSpriteProxyNode = dynamic_cast<SpriteProxyNode*>(currNode)) {
-          asSpriteProxyNode->setColor(this->getColor());
-        }
-
-        states.shader = s;
+    if (s && currNode->IsUsingParentShader()) {
+      if (auto asSpriteProxyNode = dynamic_cast<SpriteProxyNode*>(currNode)) {
+        asSpriteProxyNode->setColor(this->getColor());
       }
 
-      target.draw(*currNode, states);
+      states.shader = s;
+    }
 
-      // revert color
-      if (asSpriteProxyNode && needsRevert) {
-        asSpriteProxyNode->setColor(tempColor);
-      }
+    target.draw(*currNode, states);
 
-      // revert uniforms from this pass
-      smartShader = temp;
+    // revert color
+    if (asSpriteProxyNode && needsRevert) {
+      asSpriteProxyNode->setColor(tempColor);
     }
+
+    // revert uniforms from this pass
+    smartShader.PopState();
+  }
+
+  if (!drawnSelf) {
+    drawSelf();
   }
 }
 
@@ -1754,8 +1756,10 @@ void Entity::Blind(frame_time_t maxCooldown)
   float height = -GetHeight()/2.f;
   std::shared_ptr<AnimationComponent> anim = GetFirstComponent<AnimationComponent>();
 
-  if (anim && anim->HasPoint("head")) {
-    height = (anim->GetPoint("head") - anim->GetPoint("origin")).y;
+  static const PointId HEAD = PointNames::Intern("head");
+
+  if (anim && anim->HasPoint(HEAD)) {
+    height = (anim->GetPoint(HEAD) - anim->GetPoint(PointNames::ORIGIN)).y;
   }
 
   blindCooldown = maxCooldown;
@@ -23,9 +23,9 @@ Field::Field(int _width, int _height) :
   a.Reload();
   a << Animator::Mode::Loop;
 
-  std::shared_ptr<sf::Texture> t_a_b = handle.Textures().LoadFromFile(TexturePaths::TILE_ATLAS_BLUE);
-  std::shared_ptr<sf::Texture> t_a_r = handle.Textures().LoadFromFile(TexturePaths::TILE_ATLAS_RED);
-  std::shared_ptr<sf::Texture> t_a_u = handle.Textures().LoadFromFile(TexturePaths::TILE_ATLAS_UNK);
+  std::shared_ptr<sf::Texture> t_a_b = handle.Textures().LoadIntoAtlas(TexturePaths::TILE_ATLAS_BLUE);
+  std::shared_ptr<sf::Texture> t_a_r = handle.Textures().LoadIntoAtlas(TexturePaths::TILE_ATLAS_RED);
+  std::shared_ptr<sf::Texture> t_a_u = handle.Textures().LoadIntoAtlas(TexturePaths::TILE_ATLAS_UNK);
 
   for (int y = 0; y < _height+2; y++) {
     vector<Battle::Tile*> row = vector<Battle::Tile*>();
@@ -19,10 +19,12 @@ FolderChangeNameScene::FolderChangeNameScene(ActivityController& controller, std
 
   leave = true;
   // folder menu graphic
-  bg = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CHANGE_NAME_BG));
+  bgTexture = Textures().LoadFromFile(TexturePaths::FOLDER_CHANGE_NAME_BG);
+  bg = sf::Sprite(*bgTexture);
   bg.setScale(2.f, 2.f);
 
-  cursorPieceLeft = sf::Sprite(*Textures().LoadFromFile(TexturePaths::LETTER_CURSOR));
+  cursorPieceLeftTexture = Textures().LoadFromFile(TexturePaths::LETTER_CURSOR);
+  cursorPieceLeft = sf::Sprite(*cursorPieceLeftTexture);
   cursorPieceLeft.setScale(2.f, 2.f);
   cursorPieceLeft.setPosition(12 * 2.f, 58 * 2.f);
 
@@ -30,6 +30,7 @@ private:
   int cursorPosY; /*!< y location in column */
   int currTable;  /*!< which table we're on */
   sf::Sprite cursorPieceLeft, cursorPieceRight;
+  std::shared_ptr<sf::Texture> bgTexture, cursorPieceLeftTexture;
   Animation animatorLeft;
   Animation animatorRight;
   float elapsed;
@@ -69,21 +69,26 @@ FolderEditScene::FolderEditScene(swoosh::ActivityController& controller, CardFol
   cardDesc.setScale(2.f, 2.f);
 
   // folder menu graphic
-  bg = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_VIEW_BG));
+  bgTexture = Textures().LoadFromFile(TexturePaths::FOLDER_VIEW_BG);
+  bg = sf::Sprite(*bgTexture);
   bg.setScale(2.f, 2.f);
 
-  folderDock = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_DOCK));
+  folderDockTexture = Textures().LoadFromFile(TexturePaths::FOLDER_DOCK);
+  folderDock = sf::Sprite(*folderDockTexture);
   folderDock.setScale(2.f, 2.f);
   folderDock.setPosition(2.f, 30.f);
 
-  packDock = sf::Sprite(*Textures().LoadFromFile(TexturePaths::PACK_DOCK));
+  packDockTexture = Textures().LoadFromFile(TexturePaths::PACK_DOCK);
+  packDock = sf::Sprite(*packDockTexture);
   packDock.setScale(2.f, 2.f);
   packDock.setPosition(480.f, 30.f);
 
-  scrollbar = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scrollbarTexture = Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR);
+  scrollbar = sf::Sprite(*scrollbarTexture);
   scrollbar.setScale(2.f, 2.f);
 
-  folderCursor = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR));
+  folderCursorTexture = Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR);
+  folderCursor = sf::Sprite(*folderCursorTexture);
   folderCursor.setScale(2.f, 2.f);
   folderCursor.setPosition((2.f * 90.f), 64.0f);
   folderSwapCursor = folderCursor;
@@ -92,24 +97,29 @@ FolderEditScene::FolderEditScene(swoosh::ActivityController& controller, CardFol
   packCursor.setPosition((2.f * 90.f) + 480.0f, 64.0f);
   packSwapCursor = packCursor;
 
-  folderNextArrow = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_NEXT_ARROW));
+  folderNextArrowTexture = Textures().LoadFromFile(TexturePaths::FOLDER_NEXT_ARROW);
+  folderNextArrow = sf::Sprite(*folderNextArrowTexture);
   folderNextArrow.setScale(2.f, 2.f);
 
   packNextArrow = folderNextArrow;
   packNextArrow.setScale(-2.f, 2.f);
 
-  folderCardCountBox = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_SIZE));
+  folderCardCountBoxTexture = Textures().LoadFromFile(TexturePaths::FOLDER_SIZE);
+  folderCardCountBox = sf::Sprite(*folderCardCountBoxTexture);
   folderCardCountBox.setPosition(sf::Vector2f(425.f, 10.f + folderCardCountBox.getLocalBounds().height));
   folderCardCountBox.setScale(2.f, 2.f);
   folderCardCountBox.setOrigin(folderCardCountBox.getLocalBounds().width / 2.0f, folderCardCountBox.getLocalBounds().height / 2.0f);
 
-  cardHolder = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+  cardHolderTexture = Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER);
+  cardHolder = sf::Sprite(*cardHolderTexture);
   cardHolder.setScale(2.f, 2.f);
 
-  packCardHolder = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+  packCardHolderTexture = Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER);
+  packCardHolder = sf::Sprite(*packCardHolderTexture);
   packCardHolder.setScale(2.f, 2.f);
 
-  element = sf::Sprite(*Textures().LoadFromFile(TexturePaths::ELEMENT_ICON));
+  elementTexture = Textures().LoadFromFile(TexturePaths::ELEMENT_ICON);
+  element = sf::Sprite(*elementTexture);
   element.setScale(2.f, 2.f);
 
   // Current card graphic
@@ -139,6 +139,8 @@ private:
   swoosh::Timer easeInTimer;
 
   std::shared_ptr<sf::Texture> noPreview, noIcon;
+  std::shared_ptr<sf::Texture> bgTexture, folderDockTexture, packDockTexture, scrollbarTexture, folderCursorTexture;
+  std::shared_ptr<sf::Texture> folderNextArrowTexture, folderCardCountBoxTexture, cardHolderTexture, packCardHolderTexture, elementTexture;
 
   struct CardView {
     int maxCardsOnScreen{ 0 };
@@ -208,22 +210,25 @@ void FolderEditScene::RefreshCurrentCardDock(FolderEditScene::CardView& view, co
     // If we have selected a new card, display the appropriate texture for its type
     if (view.currCardIndex != view.prevIndex) {
       sf::Sprite& sprite = currViewMode == ViewMode::folder ? cardHolder : packCardHolder;
+      std::shared_ptr<sf::Texture>& texture = currViewMode == ViewMode::folder ? cardHolderTexture : packCardHolderTexture;
       Battle::Card card;
       slot.GetCard(card); // Returns and frees the card from the bucket, this is why we needed a copy
 
       switch (card.GetClass()) {
       case Battle::CardClass::mega:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_MEGA));
+        texture = Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_MEGA);
         break;
       case Battle::CardClass::giga:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_GIGA));
+        texture = Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_GIGA);
         break;
       case Battle::CardClass::dark:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_DARK));
+        texture = Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_DARK);
         break;
       default:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+        texture = Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER);
       }
+
+      sprite.setTexture(*texture);
     }
   }
 }
\ No newline at end of file
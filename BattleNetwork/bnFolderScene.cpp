@@ -63,32 +63,40 @@ FolderScene::FolderScene(swoosh::ActivityController &controller, CardFolderColle
   numberLabel.setPosition(sf::Vector2f(170.f, 28.0f));
 
   // folder menu graphic
-  bg = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_INFO_BG));
+  bgTexture = Textures().LoadAsync(TexturePaths::FOLDER_INFO_BG);
+  bg = sf::Sprite(*bgTexture);
   bg.setScale(2.f, 2.f);
 
-  scrollbar = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scrollbarTexture = Textures().LoadAsync(TexturePaths::FOLDER_SCROLLBAR);
+  scrollbar = sf::Sprite(*scrollbarTexture);
   scrollbar.setScale(2.f, 2.f);
   scrollbar.setPosition(410.f, 60.f);
 
-  folderBox = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_BOX));
+  folderBoxTexture = Textures().LoadAsync(TexturePaths::FOLDER_BOX);
+  folderBox = sf::Sprite(*folderBoxTexture);
   folderBox.setScale(2.f, 2.f);
 
-  folderDisabled = sf::Sprite(*Textures().LoadFromFile("resources/ui/folder_disabled.png"));
+  folderDisabledTexture = Textures().LoadAsync("resources/ui/folder_disabled.png");
+  folderDisabled = sf::Sprite(*folderDisabledTexture);
   folderDisabled.setScale(2.f, 2.f);
 
   RefreshOptions();
 
-  folderCursor = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_BOX_CURSOR));
+  folderCursorTexture = Textures().LoadAsync(TexturePaths::FOLDER_BOX_CURSOR);
+  folderCursor = sf::Sprite(*folderCursorTexture);
   folderCursor.setScale(2.f, 2.f);
 
-  folderEquip = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_EQUIP));
+  folderEquipTexture = Textures().LoadAsync(TexturePaths::FOLDER_EQUIP);
+  folderEquip = sf::Sprite(*folderEquipTexture);
   folderEquip.setScale(2.f, 2.f);
 
-  cursor = sf::Sprite(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_CURSOR));
+  cursorTexture = Textures().LoadAsync(TexturePaths::TEXT_BOX_CURSOR);
+  cursor = sf::Sprite(*cursorTexture);
   cursor.setScale(2.f, 2.f);
   cursor.setPosition(2.0, 155.0f);
 
-  element = sf::Sprite(*Textures().LoadFromFile(TexturePaths::ELEMENT_ICON));
+  elementTexture = Textures().LoadAsync(TexturePaths::ELEMENT_ICON);
+  element = sf::Sprite(*elementTexture);
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
@@ -96,7 +104,8 @@ FolderScene::FolderScene(swoosh::ActivityController &controller, CardFolderColle
   cardIcon.setScale(2.f, 2.f);
   cardIcon.setTextureRect(sf::IntRect(0, 0, 14, 14));
 
-  mbPlaceholder = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_MB));
+  mbPlaceholderTexture = Textures().LoadAsync(TexturePaths::FOLDER_MB);
+  mbPlaceholder = sf::Sprite(*mbPlaceholderTexture);
   mbPlaceholder.setScale(2.f, 2.f);
 
   equipAnimation = Animation("resources/ui/folder_equip.animation");
@@ -110,8 +119,8 @@ FolderScene::FolderScene(swoosh::ActivityController &controller, CardFolderColle
   equipAnimation.Update(0,folderEquip);
   folderCursorAnimation.Update(0, folderCursor);
 
-  noPreview = Textures().LoadFromFile(TexturePaths::CHIP_MISSINGDATA);
-  noIcon = Textures().LoadFromFile(TexturePaths::CHIP_ICON_MISSINGDATA);
+  noPreview = Textures().LoadAsync(TexturePaths::CHIP_MISSINGDATA);
+  noIcon = Textures().LoadAsync(TexturePaths::CHIP_ICON_MISSINGDATA);
 
   maxCardsOnScreen = 5;
   currCardIndex = 0;
@@ -731,7 +740,7 @@ void FolderScene::DeleteFolder(std::function<void()> onSuccess)
   questionInterface = new Question("Delete this folder?", onYes, onNo);
 
   textbox.EnqueMessage(
-    sf::Sprite(*Textures().LoadFromFile(TexturePaths::MUG_NAVIGATOR)),
+    Textures().LoadFromFile(TexturePaths::MUG_NAVIGATOR),
     "resources/ui/navigator.animation", 
     questionInterface);
 
@@ -741,8 +750,8 @@ void FolderScene::DeleteFolder(std::function<void()> onSuccess)
 void FolderScene::RefreshOptions()
 {
   const bool emptyCollection = collection.GetFolderNames().empty();
-  const std::shared_ptr<sf::Texture> folderOptionsTex = emptyCollection ? Textures().LoadFromFile(TexturePaths::FOLDER_OPTIONS_NEW) : Textures().LoadFromFile(TexturePaths::FOLDER_OPTIONS);
-  folderOptions = sf::Sprite(*folderOptionsTex);
+  folderOptionsTexture = emptyCollection ? Textures().LoadFromFile(TexturePaths::FOLDER_OPTIONS_NEW) : Textures().LoadFromFile(TexturePaths::FOLDER_OPTIONS);
+  folderOptions = sf::Sprite(*folderOptionsTexture);
   folderOptions.setOrigin(folderOptions.getGlobalBounds().width / 2.0f, folderOptions.getGlobalBounds().height / 2.0f);
 
   if (emptyCollection) {
@@ -72,6 +72,8 @@ private:
   Question* questionInterface{ nullptr };
 
   std::shared_ptr<sf::Texture> noPreview, noIcon;
+  std::shared_ptr<sf::Texture> bgTexture, scrollbarTexture, folderBoxTexture, folderDisabledTexture, folderCursorTexture;
+  std::shared_ptr<sf::Texture> folderEquipTexture, cursorTexture, elementTexture, mbPlaceholderTexture, folderOptionsTexture;
 
   int currFolderIndex{};
   int selectedFolderIndex{};
@@ -1,24 +1,22 @@
 #include "bnFont.h"
 
 std::map<char, std::string> Font::specialCharLookup;
-std::array<Animation, Font::style_sz> Font::animationArray{};
-bool Font::animationsLoaded = false;
+std::array<Font::GlyphTable, Font::style_sz> Font::glyphTables{};
+Animation Font::fontAnimation;
+
+namespace {
+  std::once_flag glyphTablesLoaded;
+}
 
 Font::Font(const Style& style) :
   style(style),
   letter('A')
 {
-  if (!Font::animationsLoaded) {
-    Font::animationArray.fill(Animation("resources/fonts/fonts_compressed.animation"));
-
-    for (auto& a : animationArray) {
-      a.Load();
-    }
-
-    Font::animationsLoaded = true;
-  }
+  LoadGlyphTables();
 
-  ApplyStyle();
+  const Glyph& glyph = GetGlyph(letter);
+  texcoords = glyph.texcoords;
+  origin = glyph.origin;
   letterATexcoords = texcoords;
 }
 
@@ -26,9 +24,32 @@ Font::~Font()
 {
 }
 
-void Font::ApplyStyle()
+void Font::LoadGlyphTables()
+{
+  std::call_once(glyphTablesLoaded, [] {
+    fontAnimation = Animation("resources/fonts/fonts_compressed.animation");
+
+    for (size_t i = 0; i < style_sz; i++) {
+      for (size_t c = 0; c < 256; c++) {
+        glyphTables[i][c] = LookupGlyph(static_cast<Style>(i), static_cast<char>(c));
+      }
+    }
+  });
+}
+
+void Font::AddSpecialChar(char letter, const std::string& animationName)
+{
+  LoadGlyphTables();
+
+  specialCharLookup.insert_or_assign(letter, animationName);
+
+  for (size_t i = 0; i < style_sz; i++) {
+    glyphTables[i][static_cast<unsigned char>(letter)] = LookupGlyph(static_cast<Style>(i), letter);
+  }
+}
+
+Font::Glyph Font::LookupGlyph(Style style, char letter)
 {
-  auto& animation = animationArray[static_cast<size_t>(style)];
   std::string animName;
 
   switch (style) {
@@ -81,7 +102,7 @@ void Font::ApplyStyle()
 
     if (letter != '"') {
       // some font cannot be lower-cased
-      if (::islower(letter) && HasLowerCase(style)) {
+      if (::islower(static_cast<unsigned char>(letter)) && HasLowerCase(style)) {
         letterStr = "LOWER_" + letterStr;
       }
 
@@ -93,16 +114,19 @@ void Font::ApplyStyle()
   }
 
   // Get the frame (list of size 1) of the font
-  FrameList list = animation.GetFrameList(animName);
+  const FrameList* list = &fontAnimation.GetFrameList(animName);
   
-  if (list.IsEmpty()) {
+  if (list->IsEmpty()) {
     // If the list is empty (font support not existing), use small letter 'A'
-    list = animation.GetFrameList("SMALL_A");
+    list = &fontAnimation.GetFrameList("SMALL_A");
+  }
+
+  if (list->IsEmpty()) {
+    return Glyph{};
   }
   
-  auto& frame = list.GetFrame(0);
-  texcoords = frame.subregion;
-  origin = frame.origin;
+  auto& frame = list->GetFrame(0);
+  return Glyph{ frame.subregion, frame.origin };
 }
 
 const bool Font::HasLowerCase(const Style& style)
@@ -134,11 +158,16 @@ const Font::Style & Font::GetStyle() const
 
 void Font::SetLetter(char letter)
 {
-  auto prev = Font::letter;
   Font::letter = letter;
 
-  if(letter != prev)
-    ApplyStyle();
+  const Glyph& glyph = GetGlyph(letter);
+  texcoords = glyph.texcoords;
+  origin = glyph.origin;
+}
+
+const Font::Glyph& Font::GetGlyph(char letter) const
+{
+  return glyphTables[static_cast<size_t>(style)][static_cast<unsigned char>(letter)];
 }
 
 const sf::Texture & Font::GetTexture() const
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <array>
+#include <mutex>
 
 class Font : ResourceHandle
 {
@@ -25,25 +26,47 @@ public:
     size // don't use!
   } style;
 
-  static std::map<char, std::string> specialCharLookup;
+  /**
+  * @brief Texture coordinates and origin of a single letter
+  */
+  struct Glyph {
+    sf::IntRect texcoords{};
+    sf::Vector2f origin{};
+  };
+
+  /**
+  * @brief Maps a char to a named entry in the font animation (e.g. buttons, symbols, multichar letters)
+  * Updates the glyph tables for that char in every style
+  */
+  static void AddSpecialChar(char letter, const std::string& animationName);
 
 private:
   static constexpr size_t style_sz = static_cast<size_t>(Style::size);
-  static bool animationsLoaded;
-  static std::array<Animation, style_sz> animationArray;
+  using GlyphTable = std::array<Glyph, 256>; //!< indexed by the char as an unsigned byte
+
+  static std::map<char, std::string> specialCharLookup;
+  static std::array<GlyphTable, style_sz> glyphTables; //!< built once, letters never need to be looked up by name again
+  static Animation fontAnimation;
 
   char letter{ 'A' };
   sf::IntRect texcoords{};
   sf::IntRect letterATexcoords{};
   sf::Vector2f origin{};
-  void ApplyStyle();
-  const bool HasLowerCase(const Style& style);
+
+  static void LoadGlyphTables();
+  static Glyph LookupGlyph(Style style, char letter);
+  static const bool HasLowerCase(const Style& style);
 public:
   Font(const Style& style);
   ~Font();
 
   const Style& GetStyle() const;
   void SetLetter(char letter);
+
+  /**
+  * @brief Get the glyph for a letter in this font's style without changing the current letter
+  */
+  const Glyph& GetGlyph(char letter) const;
   const sf::Texture& GetTexture() const;
   const sf::IntRect GetTextureCoords() const;
   const sf::Vector2f GetOrigin() const;
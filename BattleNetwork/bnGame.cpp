@@ -15,11 +15,15 @@
 #include "bnResourceHandle.h"
 #include "bnInputHandle.h"
 #include "bnRandom.h"
+#include "bnCompiledAnimation.h"
+#include "bnPackageFingerprintCache.h"
 #include "overworld/bnOverworldHomepage.h"
 #include "SFML/System.hpp"
 
 #ifdef BN_MOD_SUPPORT
 #include "bnScriptResourceManager.h"
+#include "bnLuaBytecodeCache.h"
+#include "bnLuaProfiler.h"
 #include "bindings/bnScriptedBlock.h"
 #include "bindings/bnScriptedCard.h"
 #include "bindings/bnScriptedPlayer.h"
@@ -169,6 +173,20 @@ TaskGroup Game::Boot(const cxxopts::ParseResult& values)
   isDebug = CommandLineValue<bool>("debug");
   singlethreaded = CommandLineValue<bool>("singlethreaded");
 
+#ifdef BN_MOD_SUPPORT
+  ModRegistration::SetWorkerCount(static_cast<unsigned>(std::max(0, CommandLineValue<int>("modworkers"))));
+  scriptManager.SetSharedRuntimes(CommandLineValue<bool>("sharedlua"));
+  scriptManager.SetGarbageCollectionBudget(std::max(0, CommandLineValue<int>("luagcbudget")) / 1e6);
+  LuaProfiler::SetEnabled(CommandLineValue<bool>("profilelua"));
+#endif
+
+  if (CommandLineValue<bool>("atlas")) {
+    textureManager.EnableAtlas();
+  }
+
+  textureManager.SetMemoryBudget(static_cast<size_t>(std::max(0, CommandLineValue<int>("texturebudget"))) * 1024u * 1024u);
+  audioManager.SetMemoryBudget(static_cast<size_t>(std::max(0, CommandLineValue<int>("audiobudget"))) * 1024u * 1024u);
+
   if (reader.IsOK()) {
     Logger::Log(LogLevel::warning, "config settings was not OK. Will use internal default key layout.");
   }
@@ -185,6 +203,19 @@ TaskGroup Game::Boot(const cxxopts::ParseResult& values)
 
   Logger::Logf(LogLevel::info, "Engine initialized: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
 
+  // parsed .animation files are compiled here on first load
+  CompiledAnimation::SetCacheDirectory(CacheDataPath() + "/animations");
+
+  // package hashes are remembered here so unchanged packages are not zipped again
+  PackageFingerprintCache::SetCacheDirectory(CacheDataPath() + "/packages");
+  PackageFingerprintCache::SetVerifyHashes(CommandLineValue<bool>("verify-hashes"));
+
+#ifdef BN_MOD_SUPPORT
+  // package scripts are compiled here on first load
+  LuaBytecodeCache::SetCacheDirectory(CacheDataPath() + "/scripts");
+  LuaProfiler::SetReportDirectory(AppDataPath() + "/profiles");
+#endif
+
   // does shaders too
   Callback<void()> graphics;
   graphics.Slot(std::bind(&Game::RunGraphicsInit, this, &progress));
@@ -214,22 +245,29 @@ TaskGroup Game::Boot(const cxxopts::ParseResult& values)
     inputManager.BindRegainFocusEvent(std::bind(&Game::GainFocus, this));
     inputManager.BindResizedEvent(std::bind(&Game::Resize, this, std::placeholders::_1, std::placeholders::_2));
 
-    Font::specialCharLookup.insert(std::make_pair(char(-1), "THICK_SP"));
-    Font::specialCharLookup.insert(std::make_pair(char(-2), "THICK_EX"));
-    Font::specialCharLookup.insert(std::make_pair(char(-3), "THICK_NM"));
+    Font::AddSpecialChar(char(-1), "THICK_SP");
+    Font::AddSpecialChar(char(-2), "THICK_EX");
+    Font::AddSpecialChar(char(-3), "THICK_NM");
   });
 
   this->UpdateConfigSettings(reader.GetConfigSettings());
 
+  // packages build entities that look up shaders and load sounds, so graphics and audio come first.
+  // package scripts can include libraries, so libraries load before the other packages
+  const std::vector<std::string> packageDependencies = { "Init graphics", "Init audio", "Load Libraries" };
+
   TaskGroup tasks;
   tasks.AddTask("Binding window", std::move(init));
   tasks.AddTask("Init graphics", std::move(graphics));
   tasks.AddTask("Init audio", std::move(audio));
-  tasks.AddTask("Load Libraries", std::move( libraries ) );
-  tasks.AddTask("Load Navis", std::move(navis));
-  tasks.AddTask("Load mobs", std::move(mobs));
-  tasks.AddTask("Load cards", std::move(cards));
-  tasks.AddTask("Load prog blocks", std::move(blocks));
+  tasks.AddTask("Load Libraries", std::move( libraries ), { "Init graphics", "Init audio" });
+  tasks.AddTask("Load Navis", std::move(navis), packageDependencies);
+  tasks.AddTask("Load mobs", std::move(mobs), packageDependencies);
+  tasks.AddTask("Load cards", std::move(cards), packageDependencies);
+  tasks.AddTask("Load prog blocks", std::move(blocks), packageDependencies);
+
+  // single threaded runs every task on the main thread like before
+  tasks.SetWorkerCount(singlethreaded ? 1u : static_cast<unsigned>(std::max(0, CommandLineValue<int>("bootworkers"))));
 
   // Load font symbols immediately...
   textureManager.LoadFromFile(TexturePaths::FONT);
@@ -355,8 +393,10 @@ void Game::ProcessFrame()
       }
     }
 
+    textureManager.ProcessPendingUploads();
     this->draw();        // draw game
     mouse.draw(*window.GetRenderWindow());
+    CollectScriptGarbage(clock.getElapsedTime().asSeconds());
     window.Display(); // display to screen
 
     scope_elapsed = clock.getElapsedTime().asSeconds();
@@ -378,6 +418,7 @@ void Game::RunSingleThreaded()
     // unused images need to be free'd 
     textureManager.HandleExpiredTextureCache();
     audioManager.HandleExpiredAudioCache();
+    Animation::HandleExpiredAnimationCache();
 
     double delta = 1.0 / static_cast<double>(frame_time_t::frames_per_second);
     this->elapsed += from_seconds(delta);
@@ -394,8 +435,10 @@ void Game::RunSingleThreaded()
       this->update(delta);  // update game logic
     }
     
+    textureManager.ProcessPendingUploads();
     this->draw();        // draw game
     mouse.draw(*window.GetRenderWindow());
+    CollectScriptGarbage(clock.getElapsedTime().asSeconds());
     window.Display(); // display to screen
 
     quitting = getStackSize() == 0;
@@ -404,6 +447,15 @@ void Game::RunSingleThreaded()
   }
 }
 
+void Game::CollectScriptGarbage(double frameSeconds)
+{
+#ifdef BN_MOD_SUPPORT
+  // the rest of the frame would be spent waiting to display
+  double frameLength = 1.0 / static_cast<double>(frame_time_t::frames_per_second);
+  scriptManager.CollectGarbage(frameLength - frameSeconds);
+#endif
+}
+
 void Game::Exit()
 {
   quitting = true;
@@ -423,6 +475,7 @@ void Game::Run()
     // unused images need to be free'd 
     textureManager.HandleExpiredTextureCache();
     audioManager.HandleExpiredAudioCache();
+    Animation::HandleExpiredAnimationCache();
 
     quitting = getStackSize() == 0;
   }
@@ -114,6 +114,7 @@ private:
 
   void HandleRecordingEvents();
   void UpdateMouse(double dt);
+  void CollectScriptGarbage(double frameSeconds); //!< uses the time left in the frame
   void ProcessFrame();
   void RunSingleThreaded();
   bool NextFrame();
@@ -19,6 +19,7 @@ private:
   sf::Sprite scroll;
   sf::Sprite cursor;
   sf::Sprite bg;
+  std::shared_ptr<sf::Texture> moreTextTexture, scrollTexture, cursorTexture, bgTexture;
   TextBox textbox;
   float totalElapsed{};
   signed col{}, row{}, rowOffset{};
@@ -134,29 +134,29 @@ LibraryScene::LibraryScene(swoosh::ActivityController &controller) :
   cardDesc.SetColor(sf::Color::Black);
 
   // folder menu graphic
-  bg.setTexture(Textures().LoadFromFile(TexturePaths::FOLDER_VIEW_BG));
+  bg.setTexture(Textures().LoadAsync(TexturePaths::FOLDER_VIEW_BG));
   bg.setScale(2.f, 2.f);
 
-  folderDock.setTexture(Textures().LoadFromFile(TexturePaths::FOLDER_DOCK));
+  folderDock.setTexture(Textures().LoadAsync(TexturePaths::FOLDER_DOCK));
   folderDock.setScale(2.f, 2.f);
   folderDock.setPosition(2.f, 30.f);
 
-  scrollbar.setTexture(Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scrollbar.setTexture(Textures().LoadAsync(TexturePaths::FOLDER_SCROLLBAR));
   scrollbar.setScale(2.f, 2.f);
   scrollbar.setPosition(410.f, 60.f);
 
-  cursor.setTexture(Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR));
+  cursor.setTexture(Textures().LoadAsync(TexturePaths::FOLDER_CURSOR));
   cursor.setScale(2.f, 2.f);
   cursor.setPosition((2.f*90.f), 64.0f);
 
-  stars.setTexture(Textures().LoadFromFile(TexturePaths::FOLDER_RARITY));
+  stars.setTexture(Textures().LoadAsync(TexturePaths::FOLDER_RARITY));
   stars.setScale(2.f, 2.f);
 
-  cardHolder.setTexture(Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+  cardHolder.setTexture(Textures().LoadAsync(TexturePaths::FOLDER_CHIP_HOLDER));
   cardHolder.setScale(2.f, 2.f);
   cardHolder.setPosition(4.f, 35.f);
 
-  element.setTexture(Textures().LoadFromFile(TexturePaths::ELEMENT_ICON));
+  element.setTexture(Textures().LoadAsync(TexturePaths::ELEMENT_ICON));
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
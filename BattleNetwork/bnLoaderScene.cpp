@@ -2,23 +2,27 @@
 
 void LoaderScene::ExecuteTasks()
 {
-  while (tasks.HasMore()) {
-    const std::string taskname = tasks.GetTaskName();
-    const unsigned int tasknumber = tasks.GetTaskNumber();
-    float progress = tasknumber / static_cast<float>(tasks.GetTotalTasks());
+  const float total = static_cast<float>(tasks.GetTotalTasks());
 
-    mutex.lock();
+  // independent tasks may begin and complete at the same time on different threads
+  auto begin = [this, total](const std::string& taskname, unsigned finished) {
+    float progress = finished / total;
+
+    std::scoped_lock lock(mutex);
     events.push([=] { this->onTaskBegin(taskname, progress); });
-    mutex.unlock();
+  };
 
-    tasks.DoNextTask();
-    progress = (tasknumber+1) / static_cast<float>(tasks.GetTotalTasks());
+  auto complete = [this, total](const std::string& taskname, unsigned finished) {
+    float progress = finished / total;
 
-    mutex.lock();
+    std::scoped_lock lock(mutex);
     events.push([=] { this->onTaskComplete(taskname, progress); });
+  };
 
-    mutex.unlock();
-  }
+  tasks.Run(begin, complete);
+
+  std::scoped_lock lock(mutex);
+  tasksFinished = true;
 }
 
 LoaderScene::LoaderScene(swoosh::ActivityController& controller, TaskGroup && tasks) : 
@@ -57,7 +61,7 @@ void LoaderScene::Poll()
     events.front()();
     events.pop();
   }
-  else if (!tasks.HasMore()) {
+  else if (tasksFinished) {
     isComplete = true;
   }
 }
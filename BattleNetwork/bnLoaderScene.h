@@ -28,6 +28,7 @@ private:
   std::thread taskThread;
   std::queue<std::function<void()>> events;
   bool isComplete{};
+  bool tasksFinished{}; //!< guarded by mutex
   void ExecuteTasks();
 public:
   LoaderScene(swoosh::ActivityController& controller, TaskGroup&& tasks);
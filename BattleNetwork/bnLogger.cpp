@@ -1,7 +1,472 @@
 #include "bnLogger.h"
 
-// explicitely define static member variables
-std::mutex Logger::m;
-std::queue<std::string> Logger::logs = std::queue<std::string>();
-std::ofstream Logger::file;
-uint8_t Logger::logLevel = LogLevel::critical;
\ No newline at end of file
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <thread>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  constexpr size_t BUFFER_SIZE = 4096; // must be a power of two
+  constexpr size_t HISTORY_SIZE = 512; // messages kept for GetNextLog()
+
+  /*! \brief Bounded multi-producer queue by Dmitry Vyukov, only the writer pops */
+  class RingBuffer {
+    struct Slot {
+      std::atomic<size_t> sequence{};
+      uint8_t level{};
+      std::string message;
+    };
+
+    Slot slots[BUFFER_SIZE];
+    std::atomic<size_t> enqueuePos{};
+    size_t dequeuePos{}; // guarded by the consumer mutex
+
+  public:
+    RingBuffer() {
+      for (size_t i = 0; i < BUFFER_SIZE; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    bool TryPush(uint8_t level, std::string& message) {
+      size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+      while (true) {
+        Slot& slot = slots[pos & (BUFFER_SIZE - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+          if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            slot.level = level;
+            slot.message = std::move(message);
+            slot.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (diff < 0) {
+          // full
+          return false;
+        }
+        else {
+          pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    bool TryPop(uint8_t& level, std::string& message) {
+      return TryConsume([&level, &message](uint8_t slotLevel, std::string& slotMessage) {
+        level = slotLevel;
+        message = std::move(slotMessage);
+      });
+    }
+
+    /*! \brief Hands the next message to consume(level, message) in place, nothing is allocated */
+    template<typename F>
+    bool TryConsume(F&& consume) {
+      Slot& slot = slots[dequeuePos & (BUFFER_SIZE - 1)];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+      if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePos + 1) < 0) {
+        // empty, or the next message is still being written
+        return false;
+      }
+
+      consume(slot.level, slot.message);
+      slot.message.clear();
+      slot.sequence.store(dequeuePos + BUFFER_SIZE, std::memory_order_release);
+      dequeuePos++;
+      return true;
+    }
+  };
+
+  struct LoggerState {
+    RingBuffer buffer;
+
+    std::atomic<uint8_t> consoleLevel{ LogLevel::critical };
+    std::atomic<uint8_t> fileLevel{ LogLevel::all };
+    std::atomic<Logger::OverflowPolicy> overflowPolicy{ Logger::OverflowPolicy::block };
+    std::atomic<size_t> dropped{};
+
+    // the writer thread
+    std::thread writer;
+    std::atomic<bool> running{ false }, stopping{ false }, pending{ false };
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::once_flag startFlag;
+
+    // owned by whoever drains the buffer
+    std::mutex consumerMutex;
+    std::atomic<std::thread::id> consumerOwner{}; //!< so the crash handler never locks consumerMutex on the thread holding it
+    std::ofstream file;
+    std::string fileBatch, consoleBatch;
+
+    std::mutex historyMutex;
+    std::deque<std::string> history;
+  };
+
+  LoggerState& GetState() {
+    static LoggerState state;
+    return state;
+  }
+
+  /*! \brief Locks consumerMutex and records the thread holding it */
+  class ConsumerLock {
+    LoggerState& state;
+
+  public:
+    explicit ConsumerLock(LoggerState& state) : state(state) {
+      state.consumerMutex.lock();
+      state.consumerOwner = std::this_thread::get_id();
+    }
+
+    ~ConsumerLock() {
+      state.consumerOwner = std::thread::id();
+      state.consumerMutex.unlock();
+    }
+  };
+
+  std::terminate_handler previousTerminate{ nullptr };
+
+  // consumerMutex must be held
+  void Write(LoggerState& state, uint8_t level, const std::string& message) {
+    if (level & state.fileLevel) {
+      state.fileBatch += message;
+      state.fileBatch += '\n';
+    }
+
+#if defined(__ANDROID__)
+    __android_log_print(ANDROID_LOG_INFO, "open mmbn engine", "%s", message.c_str());
+#else
+    // only print what level of error message we want to console
+    if ((level & state.consoleLevel) == level) {
+      state.consoleBatch += message;
+      state.consoleBatch += '\n';
+    }
+#endif
+
+    std::scoped_lock lock(state.historyMutex);
+    state.history.push_back(message);
+
+    if (state.history.size() > HISTORY_SIZE) {
+      state.history.pop_front();
+    }
+  }
+
+  // consumerMutex must be held
+  void WriteBatches(LoggerState& state) {
+    if (!state.consoleBatch.empty()) {
+      cerr << state.consoleBatch;
+      state.consoleBatch.clear();
+    }
+
+    if (state.fileBatch.empty()) return;
+
+    if (!state.file.is_open()) {
+      state.file.open("log.txt", std::ios::app);
+      state.file << "==============================\n";
+      state.file << "StartTime " << CurrentTime::AsString() << "\n";
+    }
+
+    state.file << state.fileBatch;
+    state.file.flush();
+    state.fileBatch.clear();
+  }
+
+  // consumerMutex must be held
+  size_t DrainLocked(LoggerState& state) {
+    size_t count = 0;
+    uint8_t level{};
+    std::string message;
+
+    if (size_t dropped = state.dropped.exchange(0)) {
+      Write(state, LogLevel::warning, "[WARNING] " + std::to_string(dropped) + " log messages were dropped, the log buffer was full");
+    }
+
+    while (state.buffer.TryPop(level, message)) {
+      Write(state, level, message);
+      count++;
+    }
+
+    WriteBatches(state);
+    return count;
+  }
+
+  size_t Drain(LoggerState& state) {
+    ConsumerLock lock(state);
+    return DrainLocked(state);
+  }
+
+  void WakeWriter(LoggerState& state) {
+    if (!state.pending.exchange(true)) {
+      state.wake.notify_one();
+    }
+  }
+
+  void RunWriter() {
+    LoggerState& state = GetState();
+
+    while (true) {
+      bool stop = state.stopping;
+      size_t written = Drain(state);
+
+      if (stop && written == 0) break;
+
+      if (written == 0) {
+        // producers do not lock to wake us, the timeout covers a missed wake up
+        std::unique_lock lock(state.wakeMutex);
+        state.wake.wait_for(lock, std::chrono::milliseconds(20), [&state] {
+          return state.pending.load() || state.stopping.load();
+        });
+        state.pending = false;
+      }
+    }
+  }
+
+#ifdef _WIN32
+  int OpenForAppend(const char* path) {
+    return _open(path, _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+  }
+
+  void WriteAll(int fd, const char* data, size_t size) {
+    _write(fd, data, static_cast<unsigned>(size));
+  }
+
+  void CloseFile(int fd) {
+    _close(fd);
+  }
+#else
+  int OpenForAppend(const char* path) {
+    return open(path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+  }
+
+  void WriteAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t written = write(fd, data, size);
+
+      if (written <= 0) return;
+
+      data += written;
+      size -= static_cast<size_t>(written);
+    }
+  }
+
+  void CloseFile(int fd) {
+    close(fd);
+  }
+#endif
+
+  // consumerMutex must be held. Writes what is still buffered without streams or allocation,
+  // the crash may have happened inside the allocator.
+  void WriteCrashLog(LoggerState& state) {
+    int fd = OpenForAppend("log.txt");
+    uint8_t fileLevel = state.fileLevel, consoleLevel = state.consoleLevel;
+
+    auto consume = [fd, fileLevel, consoleLevel](uint8_t level, std::string& message) {
+      if (fd >= 0 && (level & fileLevel)) {
+        WriteAll(fd, message.data(), message.size());
+        WriteAll(fd, "\n", 1);
+      }
+
+#if !defined(__ANDROID__)
+      if ((level & consoleLevel) == level) {
+        WriteAll(2, message.data(), message.size());
+        WriteAll(2, "\n", 1);
+      }
+#endif
+    };
+
+    while (state.buffer.TryConsume(consume)) {}
+
+    if (fd >= 0) {
+      CloseFile(fd);
+    }
+  }
+
+  void TryWriteCrashLog() {
+    LoggerState& state = GetState();
+
+    // The crashed thread may be the one holding consumerMutex, the writer or a thread in Flush().
+    // Its batch may be half written and locking again would never return, so what is left is lost.
+    if (state.consumerOwner.load() != std::this_thread::get_id() && state.consumerMutex.try_lock()) {
+      WriteCrashLog(state);
+      state.consumerMutex.unlock();
+    }
+  }
+
+  void OnTerminate() {
+    // an exception can escape from the writer or a logging call just as well as from anywhere else
+    TryWriteCrashLog();
+
+    if (previousTerminate) {
+      previousTerminate();
+    }
+
+    std::abort();
+  }
+
+  void OnCrashSignal(int signal) {
+    std::signal(signal, SIG_DFL);
+
+    TryWriteCrashLog();
+
+    std::raise(signal);
+  }
+
+  void StartWriter() {
+    LoggerState& state = GetState();
+    state.running = true;
+    state.writer = std::thread(&RunWriter);
+
+    // registered after the state is constructed so it runs before the state is destroyed
+    std::atexit(&Logger::Shutdown);
+
+    previousTerminate = std::set_terminate(&OnTerminate);
+
+    for (int signal : { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) {
+      std::signal(signal, &OnCrashSignal);
+    }
+  }
+}
+
+void Logger::SetLogLevel(uint8_t level)
+{
+  GetState().consoleLevel = level;
+}
+
+void Logger::SetFileLogLevel(uint8_t level)
+{
+  GetState().fileLevel = level;
+}
+
+void Logger::SetOverflowPolicy(OverflowPolicy policy)
+{
+  GetState().overflowPolicy = policy;
+}
+
+bool Logger::IsEnabled(uint8_t level)
+{
+  LoggerState& state = GetState();
+
+#if defined(__ANDROID__)
+  // everything goes to the android log
+  return true;
+#else
+  return (level & state.fileLevel) || (level & state.consoleLevel) == level;
+#endif
+}
+
+const bool Logger::GetNextLog(std::string& next)
+{
+  LoggerState& state = GetState();
+  std::scoped_lock lock(state.historyMutex);
+
+  if (state.history.empty())
+    return false;
+
+  next = std::move(state.history.front());
+  state.history.pop_front();
+
+  return true;
+}
+
+void Logger::Log(uint8_t level, string _message)
+{
+  if (_message.empty() || !IsEnabled(level))
+    return;
+
+  Push(level, ErrorLevel(level) + _message);
+}
+
+void Logger::Logf(uint8_t level, const char* fmt, ...)
+{
+  if (!IsEnabled(level))
+    return;
+
+  va_list vl, vl2;
+  va_start(vl, fmt);
+  va_copy(vl2, vl);
+
+  std::string ret = ErrorLevel(level);
+  size_t prefixSize = ret.size();
+
+  char buffer[512];
+  int nsize = vsnprintf(buffer, sizeof(buffer), fmt, vl);
+
+  if (nsize >= 0 && static_cast<size_t>(nsize) < sizeof(buffer)) {
+    ret.append(buffer, static_cast<size_t>(nsize));
+  }
+  else if (nsize >= 0) {
+    ret.resize(prefixSize + static_cast<size_t>(nsize) + 1);
+    vsnprintf(&ret[prefixSize], static_cast<size_t>(nsize) + 1, fmt, vl2);
+    ret.resize(prefixSize + static_cast<size_t>(nsize));
+  }
+
+  va_end(vl);
+  va_end(vl2);
+
+  Push(level, std::move(ret));
+}
+
+void Logger::Push(uint8_t level, std::string&& message)
+{
+  LoggerState& state = GetState();
+
+  std::call_once(state.startFlag, &StartWriter);
+
+  if (!state.running) {
+    // the writer has shut down, write it now
+    ConsumerLock lock(state);
+    Write(state, level, message);
+    WriteBatches(state);
+    return;
+  }
+
+  while (!state.buffer.TryPush(level, message)) {
+    if (state.overflowPolicy == OverflowPolicy::drop) {
+      state.dropped++;
+      return;
+    }
+
+    WakeWriter(state);
+    std::this_thread::yield();
+  }
+
+  WakeWriter(state);
+}
+
+void Logger::Flush()
+{
+  Drain(GetState());
+}
+
+void Logger::Shutdown()
+{
+  LoggerState& state = GetState();
+
+  if (!state.running.exchange(false)) return;
+
+  state.stopping = true;
+  state.wake.notify_one();
+
+  if (state.writer.joinable()) {
+    state.writer.join();
+  }
+
+  // messages pushed while the writer was stopping
+  Drain(state);
+  state.file.close();
+}
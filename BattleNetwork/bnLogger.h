@@ -2,6 +2,7 @@
 #include <iostream>
 #include <string>
 #include <cstdarg>
+#include <cstdint>
 #include <queue>
 #include <mutex>
 #include <fstream>
@@ -26,124 +27,74 @@ namespace LogLevel {
   const uint8_t all = info | warning | critical | debug | net;
 };
 
-/*! \brief Thread safe logging utility logs directly to a file */
+/*! \brief Thread safe logging utility logs to a file from a background thread
+ *
+ * Log() and Logf() skip messages that neither the console nor the log file wants before formatting them.
+ * Other messages go into a fixed size ring buffer that any thread can push to without taking a lock.
+ * A writer thread drains the buffer and writes to log.txt and the console in batches.
+ *
+ * When the buffer is full the caller waits for the writer or the message is dropped, see SetOverflowPolicy().
+ * Everything still buffered is written on Flush(), when the program exits and when it crashes,
+ * unless the crash happens on the thread that is writing the log.
+ */
 class Logger {
-private:
-  static std::mutex m;
-  static std::queue<std::string> logs; /*!< get the log stream in order */
-  static std::ofstream file; /*!< The file to write to */
-  static uint8_t logLevel;
-
 public:
+  enum class OverflowPolicy : uint8_t {
+    block = 0, //!< wait for the writer to make room, nothing is lost
+    drop //!< drop the message, the writer reports how many were dropped
+  };
 
   /**
   * @breif sets the log level filter so that any message that does not match will not be reported
   */
-  static void SetLogLevel(uint8_t level) {
-    logLevel = level;
-  }
+  static void SetLogLevel(uint8_t level);
+
+  /**
+  * @brief sets which levels are written to log.txt, every level is written by default
+  */
+  static void SetFileLogLevel(uint8_t level);
+
+  static void SetOverflowPolicy(OverflowPolicy policy);
+
+  /**
+  * @return true if a message at this level would be shown or written anywhere
+  */
+  static bool IsEnabled(uint8_t level);
 
   /**
    * @brief Gets the next log and stores it in the input string
    * @param next input string to store result into
    * @return true if there's more text. False if there's no text to INPUTx.
    */
-  static const bool GetNextLog(std::string &next) {
-    std::scoped_lock<std::mutex> lock(m);
-
-    if (logs.size() == 0)
-        return false;
-
-    next = logs.front();
-    logs.pop();
-
-    return (logs.size()+1 > 0);
-  }
+  static const bool GetNextLog(std::string &next);
 
   /**
    * @brief If first time opening, timestamps file and pushes message to file
    * @param _message
    */
-  static void Log(uint8_t level, string _message) {
-    std::scoped_lock<std::mutex> lock(m);
-
-    if (_message.empty())
-      return;
-
-    _message = ErrorLevel(level) + _message;
-
-    if (!file.is_open()) {
-      file.open("log.txt", std::ios::app);
-      file << "==============================" << endl;
-      file << "StartTime " << CurrentTime::AsString() << endl;
-    }
-
-#if defined(__ANDROID__)
-    __android_log_print(ANDROID_LOG_INFO, "open mmbn engine", "%s", _message.c_str());
-#else
-    if ((level & Logger::logLevel) == level) {
-      cerr << _message << endl;
-    }
-#endif
-
-    logs.push(_message);
-    file << _message << endl;
-  }
+  static void Log(uint8_t level, string _message);
 
   /**
    * @brief Uses varadic args to print any string format
    * @param fmt string format
    * @param ... input to match the format
    */
-  static void Logf(uint8_t level, const char* fmt, ...) {
-    std::scoped_lock<std::mutex> lock(m);
-
-    int size = 512;
-    char* buffer = 0;
-    buffer = new char[static_cast<size_t>(size)];
-    va_list vl, vl2;
-    va_start(vl, fmt);
-    va_copy(vl2, vl);
-    int nsize = vsnprintf(buffer, size, fmt, vl);
-    if (size <= nsize) {
-      delete[] buffer;
-      buffer = new char[static_cast<size_t>(nsize) + 1];
-      nsize = vsnprintf(buffer, size, fmt, vl2);
-    }
-    std::string ret(buffer);
-    va_end(vl);
-    va_end(vl2);
-    delete[] buffer;
+  static void Logf(uint8_t level, const char* fmt, ...);
 
-    ret = ErrorLevel(level) + ret;
-
-    // only print what level of error message we want to console
-    if ((level & Logger::logLevel) == level) {
-      cerr << ret << endl;
-    }
-
-    logs.push(ret);
-
-#if defined(__ANDROID__)
-    __android_log_print(ANDROID_LOG_INFO,"open mmbn engine","%s",ret.c_str());
-#else
-    if (!file.is_open()) {
-      file.open("log.txt", std::ios::app);
-      file << "==========================" << endl;
-      file << "StartTime " << CurrentTime::AsString() << endl;
-    }
+  /**
+  * @brief Writes every buffered message before returning
+  */
+  static void Flush();
 
-    file << ret << endl;
-#endif
-  }
+  /**
+  * @brief Stops the writer thread after writing every buffered message, later messages are written immediately
+  */
+  static void Shutdown();
 
 private:
   Logger() { ; }
 
-  /**
-   * @brief Dumps queue and closes file
-   */
-  ~Logger() { file.close(); while (!logs.empty()) { logs.pop(); } }
+  static void Push(uint8_t level, std::string&& message);
 
   static std::string ErrorLevel(uint8_t level) {
     if (level == LogLevel::critical) {
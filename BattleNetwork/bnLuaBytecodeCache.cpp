@@ -0,0 +1,264 @@
+#ifdef BN_MOD_SUPPORT
+#include "bnLuaBytecodeCache.h"
+#include "bnLogger.h"
+#include "crypto/xxhash64.h"
+
+#include <sol/sol.hpp>
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <filesystem>
+
+namespace {
+  constexpr char MAGIC[4] = { 'O', 'N', 'B', 'L' };
+  constexpr const char* EXTENSION = ".luac";
+
+  std::mutex mutex;
+  std::string cacheDir;
+  /*! \brief A compiled script and the key of the source it was compiled from */
+  struct Chunk {
+    uint64_t key{};
+    std::string bytecode; //!< lua_dump output
+  };
+
+  std::unordered_map<std::string, Chunk> chunks; //!< chunk name to its last compiled chunk
+
+  /*! \brief Identifies this build of Lua, bytecode from other releases or number types cannot be loaded */
+  std::string GetLuaSignature() {
+    std::string signature = LUA_RELEASE;
+    signature += " n" + std::to_string(sizeof(lua_Number));
+#if LUA_VERSION_NUM >= 503
+    signature += " i" + std::to_string(sizeof(lua_Integer));
+#endif
+    return signature;
+  }
+
+  uint64_t MakeKey(const std::string& chunkName, const std::string& source) {
+    static const std::string signature = GetLuaSignature();
+
+    XXH64State state;
+    XXH64Init(&state, 0);
+    XXH64Update(&state, signature.c_str(), signature.size() + 1);
+    XXH64Update(&state, chunkName.c_str(), chunkName.size() + 1);
+    XXH64Update(&state, source.data(), source.size());
+    return XXH64Digest(&state);
+  }
+
+  std::string MakeHeader(uint64_t key) {
+    std::string header(MAGIC, sizeof(MAGIC));
+    header += GetLuaSignature();
+    header.push_back('\0');
+
+    for (int i = 0; i < 8; i++) {
+      header.push_back(static_cast<char>(key >> (i * 8)));
+    }
+
+    return header;
+  }
+
+  /*! \brief Each script has one cache file named by its chunk name, so compiling new source overwrites the old chunk */
+  std::string GetCachePath(const std::string& chunkName) {
+    std::scoped_lock lock(mutex);
+
+    if (cacheDir.empty()) return {};
+
+    XXH64State state;
+    XXH64Init(&state, 0);
+    XXH64Update(&state, chunkName.data(), chunkName.size());
+
+    std::stringstream name;
+    name << std::hex << XXH64Digest(&state);
+
+    return cacheDir + "/" + name.str() + EXTENSION;
+  }
+
+  bool ReadFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) return false;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+
+    return !file.bad();
+  }
+
+  /**
+  * @brief Reads the cached chunk of a script from the cache directory
+  * @return empty if there is no file or it was compiled from other source
+  */
+  std::string ReadChunk(const std::string& chunkName, uint64_t key) {
+    std::string path = GetCachePath(chunkName);
+
+    if (path.empty()) return {};
+
+    std::string data;
+
+    if (!ReadFile(path, data)) return {};
+
+    std::string header = MakeHeader(key);
+
+    if (data.size() <= header.size() || data.compare(0, header.size(), header) != 0) {
+      return {};
+    }
+
+    return data.substr(header.size());
+  }
+
+  void WriteChunk(const std::string& chunkName, uint64_t key, const std::string& bytecode) {
+    std::string path = GetCachePath(chunkName);
+
+    if (path.empty()) return;
+
+    // write beside the final file and swap it in so readers never see a partial chunk
+    std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    {
+      std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+      if (!file) return;
+
+      std::string header = MakeHeader(key);
+      file.write(header.data(), header.size());
+      file.write(bytecode.data(), bytecode.size());
+
+      if (!file) return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec) {
+      std::filesystem::remove(tempPath, ec);
+      Logger::Logf(LogLevel::debug, "Could not cache compiled script %s", path.c_str());
+    }
+  }
+
+  int DumpWriter(lua_State*, const void* p, size_t size, void* userdata) {
+    static_cast<std::string*>(userdata)->append(static_cast<const char*>(p), size);
+    return 0;
+  }
+
+  /**
+  * @brief Dumps the function on top of the stack
+  */
+  std::string Dump(lua_State* L) {
+    std::string bytecode;
+
+#if LUA_VERSION_NUM >= 503
+    int status = lua_dump(L, &DumpWriter, &bytecode, 0);
+#else
+    int status = lua_dump(L, &DumpWriter, &bytecode);
+#endif
+
+    if (status != 0) {
+      bytecode.clear();
+    }
+
+    return bytecode;
+  }
+}
+
+void LuaBytecodeCache::SetCacheDirectory(const std::string& dir)
+{
+  std::scoped_lock lock(mutex);
+  cacheDir = dir;
+
+  if (!cacheDir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+
+    if (ec) {
+      Logger::Logf(LogLevel::warning, "Could not create script cache directory %s", cacheDir.c_str());
+      cacheDir.clear();
+    }
+  }
+}
+
+int LuaBytecodeCache::LoadFile(lua_State* L, const std::string& path)
+{
+  std::string source;
+
+  if (!ReadFile(path, source)) {
+    // let lua report the missing file the usual way
+    return luaL_loadfilex(L, path.c_str(), "t");
+  }
+
+  // precompiled files on disk are loaded as they are
+  if (source.size() && source[0] == LUA_SIGNATURE[0]) {
+    return luaL_loadfilex(L, path.c_str(), nullptr);
+  }
+
+  // same chunk name luaL_loadfilex() gives files
+  std::string chunkName = "@" + path;
+
+  // luaL_loadfilex() skips a UTF-8 BOM and a leading # line, keeping the newline so line numbers match
+  size_t start = 0;
+
+  if (source.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+    start = 3;
+  }
+
+  if (start < source.size() && source[start] == '#') {
+    start = source.find('\n', start);
+    start = start == std::string::npos ? source.size() : start;
+  }
+
+  uint64_t key = MakeKey(chunkName, source);
+  std::string bytecode;
+
+  {
+    std::scoped_lock lock(mutex);
+    auto iter = chunks.find(chunkName);
+
+    if (iter != chunks.end() && iter->second.key == key) {
+      bytecode = iter->second.bytecode;
+    }
+  }
+
+  bool fromDisk = false;
+
+  if (bytecode.empty()) {
+    bytecode = ReadChunk(chunkName, key);
+    fromDisk = !bytecode.empty();
+  }
+
+  if (!bytecode.empty()) {
+    if (luaL_loadbufferx(L, bytecode.data(), bytecode.size(), chunkName.c_str(), "b") == LUA_OK) {
+      if (fromDisk) {
+        std::scoped_lock lock(mutex);
+        chunks[chunkName] = Chunk{ key, std::move(bytecode) };
+      }
+
+      return LUA_OK;
+    }
+
+    Logger::Logf(LogLevel::debug, "Compiled script for %s could not be loaded, compiling source", path.c_str());
+    lua_pop(L, 1);
+  }
+
+  int status = luaL_loadbufferx(L, source.data() + start, source.size() - start, chunkName.c_str(), "t");
+
+  if (status != LUA_OK) {
+    return status;
+  }
+
+  bytecode = Dump(L);
+
+  if (bytecode.empty()) {
+    return LUA_OK;
+  }
+
+  WriteChunk(chunkName, key, bytecode);
+
+  std::scoped_lock lock(mutex);
+  chunks[chunkName] = Chunk{ key, std::move(bytecode) };
+
+  return LUA_OK;
+}
+
+#endif
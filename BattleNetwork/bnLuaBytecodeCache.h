@@ -0,0 +1,43 @@
+/*! \file bnLuaBytecodeCache.h */
+
+/*! \brief Keeps compiled Lua chunks so package scripts are not parsed again
+ *
+ * Packages usually get their own lua state, so shared scripts are parsed and compiled
+ * once per state that loads them. Compiled chunks (lua_dump output) are kept in memory
+ * for the rest of the session and written to the cache directory for later launches.
+ *
+ * Each script keeps one chunk, in memory under its chunk name and on disk in a file named by
+ * a hash of the chunk name. The header stores a key, an XXH64 hash of the Lua version,
+ * the chunk name and the script source. The chunk name is part of the key because the
+ * compiled chunk remembers it, and ScriptResourceManager resolves include() paths from it.
+ * A cached chunk is only used when its key matches the current source, otherwise the
+ * source is compiled and overwrites it, so editing a script never runs stale code.
+ *
+ * ```
+ * header   : magic "ONBL", Lua release string, key
+ * bytecode : lua_dump output with debug info kept for error messages
+ * ```
+ */
+
+#pragma once
+#ifdef BN_MOD_SUPPORT
+
+#include <string>
+
+struct lua_State;
+
+namespace LuaBytecodeCache {
+  /**
+  * @brief Set the directory compiled chunks are written to
+  * @param dir if empty, chunks are only kept in memory
+  */
+  void SetCacheDirectory(const std::string& dir);
+
+  /**
+  * @brief Loads the script at path as a function on top of the stack, the same as luaL_loadfilex()
+  * @return a lua status code, on error the message is pushed instead
+  */
+  int LoadFile(lua_State* L, const std::string& path);
+}
+
+#endif
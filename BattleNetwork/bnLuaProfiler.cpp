@@ -0,0 +1,287 @@
+#ifdef BN_MOD_SUPPORT
+#include "bnLuaProfiler.h"
+#include "bnLogger.h"
+
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace LuaProfiler {
+  struct StateCounters {
+    lua_Alloc alloc{ nullptr }; //!< the allocator this one forwards to
+    void* allocData{ nullptr };
+    std::string name;
+
+    // updated by the logic thread, read by the render thread for the overlay
+    std::atomic<int64_t> nanos{};
+    std::atomic<uint64_t> calls{};
+    std::atomic<uint64_t> bytesAllocated{};
+    std::atomic<uint64_t> allocations{};
+    std::atomic<int64_t> longestNanos{};
+  };
+}
+
+namespace {
+  using LuaProfiler::StateCounters;
+
+  std::atomic<bool> enabled{ false };
+  std::mutex mutex;
+  std::string reportDir;
+  std::unordered_map<lua_State*, std::unique_ptr<StateCounters>> states;
+  thread_local LuaProfiler::CallScope* currentScope{ nullptr };
+
+  std::atomic<int64_t> collectionNanos{};
+  std::atomic<int64_t> longestCollectionNanos{};
+  std::atomic<uint64_t> collectionFrames{};
+
+  // only the frame thread writes, so a plain load and store is enough
+  void StoreMax(std::atomic<int64_t>& max, int64_t value) {
+    if (value > max.load(std::memory_order_relaxed)) {
+      max.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  void* ProfilingAlloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    auto* counters = static_cast<StateCounters*>(ud);
+
+    // when ptr is null osize is the type of the new object, not a size
+    size_t oldSize = ptr ? osize : 0;
+
+    if (nsize > oldSize) {
+      counters->bytesAllocated.fetch_add(nsize - oldSize, std::memory_order_relaxed);
+      counters->allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return counters->alloc(counters->allocData, ptr, osize, nsize);
+  }
+
+  StateCounters* FindCounters(lua_State* L) {
+    if (!L) return nullptr;
+
+    void* ud = nullptr;
+
+    if (lua_getallocf(L, &ud) != &ProfilingAlloc) {
+      return nullptr;
+    }
+
+    return static_cast<StateCounters*>(ud);
+  }
+
+  std::string MakeTimestamp() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32]{};
+    std::strftime(buffer, sizeof(buffer), "%Y%m%d-%H%M%S", std::localtime(&now));
+    return buffer;
+  }
+
+  std::string EscapeCSV(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+      return value;
+    }
+
+    std::string escaped = "\"";
+
+    for (char c : value) {
+      if (c == '"') escaped += '"';
+      escaped += c;
+    }
+
+    return escaped + "\"";
+  }
+}
+
+void LuaProfiler::SetEnabled(bool enable)
+{
+  enabled = enable;
+}
+
+bool LuaProfiler::IsEnabled()
+{
+  return enabled;
+}
+
+void LuaProfiler::SetReportDirectory(const std::string& dir)
+{
+  std::scoped_lock lock(mutex);
+  reportDir = dir;
+}
+
+void LuaProfiler::Attach(lua_State* L, const std::string& name)
+{
+  if (!enabled || !L) return;
+
+  auto counters = std::make_unique<StateCounters>();
+  counters->name = name;
+  counters->alloc = lua_getallocf(L, &counters->allocData);
+
+  if (counters->alloc == &ProfilingAlloc) return;
+
+  lua_setallocf(L, &ProfilingAlloc, counters.get());
+
+  std::scoped_lock lock(mutex);
+  states[L] = std::move(counters);
+}
+
+void LuaProfiler::SetName(lua_State* L, const std::string& name)
+{
+  std::scoped_lock lock(mutex);
+  auto iter = states.find(L);
+
+  if (iter != states.end()) {
+    iter->second->name = name;
+  }
+}
+
+void LuaProfiler::Detach(lua_State* L)
+{
+  std::scoped_lock lock(mutex);
+  states.erase(L);
+}
+
+void LuaProfiler::Reset()
+{
+  std::scoped_lock lock(mutex);
+
+  for (auto& [L, counters] : states) {
+    counters->nanos = 0;
+    counters->calls = 0;
+    counters->bytesAllocated = 0;
+    counters->allocations = 0;
+    counters->longestNanos = 0;
+  }
+
+  collectionNanos = 0;
+  longestCollectionNanos = 0;
+  collectionFrames = 0;
+}
+
+void LuaProfiler::RecordCollection(double seconds)
+{
+  if (!enabled) return;
+
+  int64_t nanos = static_cast<int64_t>(seconds * 1e9);
+  collectionNanos.fetch_add(nanos, std::memory_order_relaxed);
+  collectionFrames.fetch_add(1, std::memory_order_relaxed);
+  StoreMax(longestCollectionNanos, nanos);
+}
+
+LuaProfiler::CollectionStats LuaProfiler::GetCollectionStats()
+{
+  CollectionStats stats;
+  stats.seconds = collectionNanos.load(std::memory_order_relaxed) / 1e9;
+  stats.longest = longestCollectionNanos.load(std::memory_order_relaxed) / 1e9;
+  stats.frames = collectionFrames.load(std::memory_order_relaxed);
+  return stats;
+}
+
+std::vector<LuaProfiler::PackageStats> LuaProfiler::Snapshot()
+{
+  std::vector<PackageStats> result;
+
+  {
+    std::scoped_lock lock(mutex);
+    result.reserve(states.size());
+
+    for (auto& [L, counters] : states) {
+      PackageStats stats;
+      stats.name = counters->name;
+      stats.seconds = counters->nanos.load(std::memory_order_relaxed) / 1e9;
+      stats.calls = counters->calls.load(std::memory_order_relaxed);
+      stats.bytesAllocated = counters->bytesAllocated.load(std::memory_order_relaxed);
+      stats.allocations = counters->allocations.load(std::memory_order_relaxed);
+      stats.longestCall = counters->longestNanos.load(std::memory_order_relaxed) / 1e9;
+      result.push_back(std::move(stats));
+    }
+  }
+
+  std::sort(result.begin(), result.end(), [](const PackageStats& a, const PackageStats& b) {
+    return a.seconds > b.seconds;
+  });
+
+  return result;
+}
+
+std::string LuaProfiler::WriteReport(const std::string& label)
+{
+  if (!enabled) return {};
+
+  std::string dir;
+
+  {
+    std::scoped_lock lock(mutex);
+    dir = reportDir;
+  }
+
+  if (dir.empty()) return {};
+
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+
+  std::string path = dir + "/" + label + "-" + MakeTimestamp() + ".csv";
+  std::ofstream file(path, std::ios::trunc);
+
+  if (!file) {
+    Logger::Logf(LogLevel::warning, "Could not write lua profile to %s", path.c_str());
+    return {};
+  }
+
+  file << "package,seconds,calls,bytes allocated,allocations,longest call\n";
+
+  for (const PackageStats& stats : Snapshot()) {
+    file << EscapeCSV(stats.name) << ","
+      << stats.seconds << ","
+      << stats.calls << ","
+      << stats.bytesAllocated << ","
+      << stats.allocations << ","
+      << stats.longestCall << "\n";
+  }
+
+  // frames spent collecting are counted as calls
+  CollectionStats collection = GetCollectionStats();
+  file << "[frame garbage collection],"
+    << collection.seconds << ","
+    << collection.frames << ",0,0,"
+    << collection.longest << "\n";
+
+  Logger::Logf(LogLevel::info, "Lua profile written to %s", path.c_str());
+  return path;
+}
+
+LuaProfiler::CallScope::CallScope(lua_State* L)
+{
+  if (!enabled) return;
+
+  counters = FindCounters(L);
+
+  if (!counters) return;
+
+  parent = currentScope;
+  currentScope = this;
+  start = std::chrono::steady_clock::now();
+}
+
+LuaProfiler::CallScope::~CallScope()
+{
+  if (!counters) return;
+
+  int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+  counters->nanos.fetch_add(elapsed - childNanos, std::memory_order_relaxed);
+  counters->calls.fetch_add(1, std::memory_order_relaxed);
+  StoreMax(counters->longestNanos, elapsed - childNanos);
+
+  if (parent) {
+    parent->childNanos += elapsed;
+  }
+
+  currentScope = parent;
+}
+
+#endif
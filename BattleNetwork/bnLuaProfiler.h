@@ -0,0 +1,107 @@
+/*! \file bnLuaProfiler.h */
+
+/*! \brief Measures how much time and memory each package's scripts use
+ *
+ * Disabled unless SetEnabled(true) is called before packages load.
+ *
+ * Every lua state is attached when ScriptResourceManager creates it. Attaching wraps the
+ * state's allocator (lua_setallocf) so bytes allocated are counted against the state.
+ * The CallLua* helpers in bnSolHelpers.h open a CallScope around each call into lua, which
+ * counts the call and its wall time. Time spent in nested calls into other packages is
+ * only counted against the innermost package.
+ *
+ * A state belongs to one package unless lua runtimes are shared, then it is reported
+ * once for the whole namespace.
+ */
+
+#pragma once
+#ifdef BN_MOD_SUPPORT
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+namespace LuaProfiler {
+  struct StateCounters;
+
+  struct PackageStats {
+    std::string name;
+    double seconds{}; //!< wall time spent in this package's scripts
+    uint64_t calls{};
+    uint64_t bytesAllocated{};
+    uint64_t allocations{};
+    double longestCall{}; //!< seconds, garbage collection pauses show up here
+  };
+
+  /*! \brief Garbage collection run by ScriptResourceManager::CollectGarbage() between frames */
+  struct CollectionStats {
+    double seconds{};
+    double longest{}; //!< longest frame spent collecting
+    uint64_t frames{}; //!< frames that collected anything
+  };
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled();
+
+  /**
+  * @brief Set the directory WriteReport() writes to
+  */
+  void SetReportDirectory(const std::string& dir);
+
+  /**
+  * @brief Starts counting for L. Does nothing while the profiler is disabled.
+  * @param name the package reported for this state
+  */
+  void Attach(lua_State* L, const std::string& name);
+
+  /**
+  * @brief Renames an attached state, used once the package id is known
+  */
+  void SetName(lua_State* L, const std::string& name);
+
+  /**
+  * @brief Forgets L. Must be called after the state is closed, closing it still uses the allocator.
+  */
+  void Detach(lua_State* L);
+
+  /**
+  * @brief Counts time spent collecting garbage between frames
+  */
+  void RecordCollection(double seconds);
+
+  CollectionStats GetCollectionStats();
+
+  /**
+  * @brief Zeroes the counters of every attached state and the garbage collection counters
+  */
+  void Reset();
+
+  /**
+  * @brief Counters of every attached state, most time first
+  */
+  std::vector<PackageStats> Snapshot();
+
+  /**
+  * @brief Writes Snapshot() to a new csv file in the report directory
+  * @return the file path or an empty string if nothing was written
+  */
+  std::string WriteReport(const std::string& label);
+
+  /*! \brief Counts a call into lua and the time until it returns */
+  class CallScope {
+    StateCounters* counters{ nullptr };
+    CallScope* parent{ nullptr };
+    std::chrono::steady_clock::time_point start;
+    int64_t childNanos{};
+  public:
+    CallScope(lua_State* L);
+    ~CallScope();
+    CallScope(const CallScope&) = delete;
+    CallScope& operator=(const CallScope&) = delete;
+  };
+}
+
+#endif
@@ -52,16 +52,20 @@ MailScene::MailScene(swoosh::ActivityController& controller, Inbox& inbox) :
 {
   label.setScale(2.f, 2.f);
 
-  moreText.setTexture(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR));
+  moreTextTexture = Textures().LoadFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR);
+  moreText.setTexture(*moreTextTexture);
   moreText.setScale(2.f, 2.f);
 
-  scroll.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scrollTexture = Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR);
+  scroll.setTexture(*scrollTexture);
   scroll.setScale(2.f, 2.f);
 
-  cursor.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR));
+  cursorTexture = Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR);
+  cursor.setTexture(*cursorTexture);
   cursor.setScale(2.f, 2.f);
 
-  bg.setTexture(*Textures().LoadFromFile("resources/scenes/items/bg.png"), true);
+  bgTexture = Textures().LoadFromFile("resources/scenes/items/bg.png");
+  bg.setTexture(*bgTexture, true);
   bg.setScale(2.f, 2.f);
 
   iconTexture = Textures().LoadFromFile("resources/scenes/mail/icons.png");
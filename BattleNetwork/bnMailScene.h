@@ -19,6 +19,7 @@ private:
   sf::Sprite cursor;
   sf::Sprite bg;
   sf::Sprite newSprite;
+  std::shared_ptr<sf::Texture> moreTextTexture, scrollTexture, cursorTexture, bgTexture;
   std::shared_ptr<sf::Texture> iconTexture, noMug;
   TextBox textbox;
   Animation iconAnim, newAnim;
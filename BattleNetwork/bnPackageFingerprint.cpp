@@ -0,0 +1,72 @@
+#include "bnPackageFingerprint.h"
+#include "stx/zip_utils.h"
+#include "stx/crypto_utils.h"
+
+#include <atomic>
+
+namespace {
+  std::atomic<PackageFingerprint::Algorithm> currentAlgorithm{ PackageFingerprint::Algorithm::md5 };
+
+  stx::result_t<std::string> HashZip(const std::string& packagePath, const std::string& zipPath) {
+    stx::result_t<bool> zip_result = stx::zip(packagePath, zipPath);
+
+    if (zip_result.is_error()) {
+      return stx::error<std::string>(zip_result.error_cstr());
+    }
+
+    return stx::generate_md5_from_file(zipPath);
+  }
+}
+
+void PackageFingerprint::SetAlgorithm(Algorithm algorithm)
+{
+  currentAlgorithm = algorithm;
+}
+
+PackageFingerprint::Algorithm PackageFingerprint::GetAlgorithm()
+{
+  return currentAlgorithm;
+}
+
+const char* PackageFingerprint::GetName(Algorithm algorithm)
+{
+  switch (algorithm) {
+  case Algorithm::content:
+    return "content";
+  case Algorithm::md5:
+  default:
+    return "md5";
+  }
+}
+
+std::optional<PackageFingerprint::Algorithm> PackageFingerprint::ParseAlgorithm(const std::string& name)
+{
+  for (Algorithm algorithm : { Algorithm::md5, Algorithm::content }) {
+    if (name == GetName(algorithm)) {
+      return algorithm;
+    }
+  }
+
+  return {};
+}
+
+stx::result_t<std::string> PackageFingerprint::Hash(const std::string& packagePath, Algorithm algorithm)
+{
+  return Hash(packagePath, algorithm, packagePath + ".zip");
+}
+
+stx::result_t<std::string> PackageFingerprint::Hash(const std::string& packagePath, Algorithm algorithm, const std::string& zipPath)
+{
+  switch (algorithm) {
+  case Algorithm::content:
+    return stx::generate_xxh64_from_directory(packagePath);
+  case Algorithm::md5:
+  default:
+    return HashZip(packagePath, zipPath);
+  }
+}
+
+stx::result_t<std::string> PackageFingerprint::Hash(const std::string& packagePath)
+{
+  return Hash(packagePath, GetAlgorithm());
+}
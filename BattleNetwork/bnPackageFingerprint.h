@@ -0,0 +1,54 @@
+/*! \file bnPackageFingerprint.h */
+
+/*! \brief Computes the fingerprint that identifies the contents of a package
+ *
+ * Two algorithms are available:
+ *
+ * - md5: zips the package folder next to itself and hashes the zip with MD5.
+ *   Zip entries carry timestamps, so identical folders can hash differently.
+ *   Older clients, servers and whitelists only understand this one.
+ * - content: streams every file in sorted path order through XXH64 without a zip.
+ *   Identical folders always hash the same, and it is much faster on large packages.
+ *
+ * Every client in a match must use the same algorithm, so md5 stays the default
+ * until everyone has moved over.
+ */
+
+#pragma once
+#include "stx/result.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace PackageFingerprint {
+  enum class Algorithm : uint8_t {
+    md5 = 0,
+    content
+  };
+
+  void SetAlgorithm(Algorithm algorithm);
+  Algorithm GetAlgorithm();
+
+  const char* GetName(Algorithm algorithm);
+
+  /**
+  * @brief Reads an algorithm by the name GetName() returns
+  */
+  std::optional<Algorithm> ParseAlgorithm(const std::string& name);
+
+  /**
+  * @brief Hashes the package folder with the algorithm. Safe to call from any thread.
+  */
+  stx::result_t<std::string> Hash(const std::string& packagePath, Algorithm algorithm);
+
+  /**
+  * @brief Same as Hash() but md5 writes its zip to zipPath instead of next to the package
+  */
+  stx::result_t<std::string> Hash(const std::string& packagePath, Algorithm algorithm, const std::string& zipPath);
+
+  /**
+  * @brief Hashes the package folder with the algorithm from SetAlgorithm()
+  */
+  stx::result_t<std::string> Hash(const std::string& packagePath);
+}
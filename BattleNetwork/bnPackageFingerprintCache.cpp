@@ -0,0 +1,274 @@
+#include "bnPackageFingerprintCache.h"
+#include "bnLogger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+// TODO: mac os < 10.5 file system support...
+#ifndef __APPLE__
+#include <filesystem>
+#endif
+
+namespace {
+  constexpr const char* HEADER = "ONB package fingerprints";
+  constexpr int VERSION = 2;
+  constexpr const char* FILENAME = "packages.db";
+
+  struct Entry {
+    PackageFingerprint::Algorithm algorithm{};
+    std::string hash;
+    PackageFingerprintCache::Manifest manifest;
+  };
+
+  std::mutex mutex;
+  std::string cacheDir;
+  std::unordered_map<std::string, Entry> entries;
+  bool verifyHashes{};
+  bool dirty{};
+
+  std::vector<std::string> Split(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+
+    while (true) {
+      size_t end = line.find('\t', start);
+
+      if (end == std::string::npos) {
+        fields.push_back(line.substr(start));
+        break;
+      }
+
+      fields.push_back(line.substr(start, end - start));
+      start = end + 1;
+    }
+
+    return fields;
+  }
+
+  bool ParseNumber(const std::string& str, uint64_t& out) {
+    try {
+      size_t read = 0;
+      out = std::stoull(str, &read);
+      return read == str.size();
+    }
+    catch (std::exception&) {
+      return false;
+    }
+  }
+
+  bool ParseNumber(const std::string& str, int64_t& out) {
+    try {
+      size_t read = 0;
+      out = std::stoll(str, &read);
+      return read == str.size();
+    }
+    catch (std::exception&) {
+      return false;
+    }
+  }
+
+  /**
+  * @brief Reads the database into entries, a damaged database is thrown out entirely
+  */
+  void Load(const std::string& dbPath) {
+    std::ifstream file(dbPath);
+
+    if (!file) return;
+
+    std::string line;
+
+    if (!std::getline(file, line) || line != std::string(HEADER) + " " + std::to_string(VERSION)) {
+      Logger::Logf(LogLevel::debug, "Package fingerprint cache %s is out of date", dbPath.c_str());
+      return;
+    }
+
+    std::unordered_map<std::string, Entry> loaded;
+
+    while (std::getline(file, line)) {
+      std::vector<std::string> fields = Split(line);
+      uint64_t count{};
+
+      std::optional<PackageFingerprint::Algorithm> algorithm;
+
+      if (fields.size() == 5 && fields[0] == "package") {
+        algorithm = PackageFingerprint::ParseAlgorithm(fields[2]);
+      }
+
+      if (!algorithm || !ParseNumber(fields[4], count)) {
+        Logger::Logf(LogLevel::warning, "Package fingerprint cache %s is damaged, every package will be hashed", dbPath.c_str());
+        return;
+      }
+
+      std::string packagePath = fields[1];
+      Entry entry;
+      entry.algorithm = *algorithm;
+      entry.hash = fields[3];
+
+      for (uint64_t i = 0; i < count; i++) {
+        PackageFingerprintCache::FileStamp stamp;
+
+        if (!std::getline(file, line)) {
+          fields.clear();
+        }
+        else {
+          fields = Split(line);
+        }
+
+        if (fields.size() != 4 || fields[0] != "file" || !ParseNumber(fields[2], stamp.size) || !ParseNumber(fields[3], stamp.modified)) {
+          Logger::Logf(LogLevel::warning, "Package fingerprint cache %s is damaged, every package will be hashed", dbPath.c_str());
+          return;
+        }
+
+        stamp.path = fields[1];
+        entry.manifest.push_back(std::move(stamp));
+      }
+
+      loaded[packagePath] = std::move(entry);
+    }
+
+    entries = std::move(loaded);
+  }
+}
+
+void PackageFingerprintCache::SetCacheDirectory(const std::string& dir)
+{
+  std::scoped_lock lock(mutex);
+  cacheDir = dir;
+  entries.clear();
+  dirty = false;
+
+#ifndef __APPLE__
+  if (cacheDir.empty()) return;
+
+  std::error_code ec;
+  std::filesystem::create_directories(cacheDir, ec);
+
+  if (ec) {
+    Logger::Logf(LogLevel::warning, "Could not create package cache directory %s", cacheDir.c_str());
+    cacheDir.clear();
+    return;
+  }
+
+  Load(cacheDir + "/" + FILENAME);
+#endif
+}
+
+void PackageFingerprintCache::SetVerifyHashes(bool enabled)
+{
+  std::scoped_lock lock(mutex);
+  verifyHashes = enabled;
+}
+
+std::optional<PackageFingerprintCache::Manifest> PackageFingerprintCache::ReadManifest(const std::string& packagePath)
+{
+#ifndef __APPLE__
+  Manifest manifest;
+  std::error_code ec;
+  std::filesystem::path root(packagePath);
+
+  for (auto iter = std::filesystem::recursive_directory_iterator(root, ec); !ec && iter != std::filesystem::recursive_directory_iterator(); iter.increment(ec)) {
+    if (!iter->is_regular_file(ec) || ec) continue;
+
+    FileStamp stamp;
+    stamp.path = iter->path().lexically_relative(root).generic_string();
+    stamp.size = static_cast<uint64_t>(iter->file_size(ec));
+    if (ec) return {};
+
+    auto modified = iter->last_write_time(ec);
+    if (ec) return {};
+
+    stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+    manifest.push_back(std::move(stamp));
+  }
+
+  if (ec) return {};
+
+  std::sort(manifest.begin(), manifest.end(), [](const FileStamp& a, const FileStamp& b) {
+    return a.path < b.path;
+  });
+
+  return manifest;
+#else
+  return {};
+#endif
+}
+
+std::optional<std::string> PackageFingerprintCache::Find(const std::string& packagePath, PackageFingerprint::Algorithm algorithm, const Manifest& manifest)
+{
+  std::scoped_lock lock(mutex);
+
+  if (verifyHashes) return {};
+
+  auto iter = entries.find(packagePath);
+
+  if (iter == entries.end() || iter->second.algorithm != algorithm || iter->second.manifest != manifest) {
+    return {};
+  }
+
+  return iter->second.hash;
+}
+
+void PackageFingerprintCache::Store(const std::string& packagePath, PackageFingerprint::Algorithm algorithm, Manifest manifest, const std::string& hash)
+{
+  std::scoped_lock lock(mutex);
+
+  Entry& entry = entries[packagePath];
+  entry.algorithm = algorithm;
+  entry.hash = hash;
+  entry.manifest = std::move(manifest);
+  dirty = true;
+}
+
+void PackageFingerprintCache::Save()
+{
+  std::scoped_lock lock(mutex);
+
+  if (!dirty || cacheDir.empty()) return;
+
+#ifndef __APPLE__
+  std::string dbPath = cacheDir + "/" + FILENAME;
+  std::string tempPath = dbPath + ".tmp";
+
+  {
+    std::ofstream file(tempPath, std::ios::trunc);
+
+    if (!file) {
+      Logger::Logf(LogLevel::debug, "Could not write package fingerprint cache %s", tempPath.c_str());
+      return;
+    }
+
+    file << HEADER << " " << VERSION << "\n";
+
+    for (auto& [path, entry] : entries) {
+      // packages that were deleted do not need to be remembered
+      std::error_code ec;
+      if (!std::filesystem::is_directory(path, ec)) continue;
+
+      file << "package\t" << path << "\t" << PackageFingerprint::GetName(entry.algorithm) << "\t" << entry.hash << "\t" << entry.manifest.size() << "\n";
+
+      for (const FileStamp& stamp : entry.manifest) {
+        file << "file\t" << stamp.path << "\t" << stamp.size << "\t" << stamp.modified << "\n";
+      }
+    }
+
+    if (!file) {
+      Logger::Logf(LogLevel::debug, "Could not write package fingerprint cache %s", tempPath.c_str());
+      return;
+    }
+  }
+
+  // swap in the complete file so a crash never leaves a partial database
+  std::error_code ec;
+  std::filesystem::rename(tempPath, dbPath, ec);
+
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+    Logger::Logf(LogLevel::debug, "Could not write package fingerprint cache %s", dbPath.c_str());
+    return;
+  }
+
+  dirty = false;
+#endif
+}
@@ -0,0 +1,72 @@
+/*! \file bnPackageFingerprintCache.h */
+
+/*! \brief Remembers package hashes between launches
+ *
+ * Hashing a package reads every file in it, which is the bulk of the work when booting
+ * with many packages. The hash is stored with a manifest of every file
+ * in the package folder (relative path, size and modified time). On later launches the
+ * stored hash is reused while the manifest still matches, so only packages whose
+ * contents changed are zipped and hashed again.
+ *
+ * The database is a text file in the cache directory:
+ *
+ * ```
+ * ONB package fingerprints <version>
+ * package <tab> absolute folder path <tab> algorithm <tab> hash <tab> file count
+ * file <tab> relative path <tab> size <tab> modified time
+ * ```
+ */
+
+#pragma once
+#include "bnPackageFingerprint.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace PackageFingerprintCache {
+  struct FileStamp {
+    std::string path; //!< relative to the package folder
+    uint64_t size{};
+    int64_t modified{};
+
+    bool operator==(const FileStamp& other) const {
+      return size == other.size && modified == other.modified && path == other.path;
+    }
+  };
+
+  using Manifest = std::vector<FileStamp>;
+
+  /**
+  * @brief Loads the database from dir, it is written back to the same directory by Save()
+  * @param dir if empty, nothing is remembered between launches
+  */
+  void SetCacheDirectory(const std::string& dir);
+
+  /**
+  * @brief When enabled, stored hashes are never reused and every package is hashed again
+  */
+  void SetVerifyHashes(bool enabled);
+
+  /**
+  * @brief Lists every file in the package folder sorted by path
+  * @return nothing if the folder could not be read
+  */
+  std::optional<Manifest> ReadManifest(const std::string& packagePath);
+
+  /**
+  * @brief Returns the stored hash for the package if it was hashed by algorithm with the same manifest
+  */
+  std::optional<std::string> Find(const std::string& packagePath, PackageFingerprint::Algorithm algorithm, const Manifest& manifest);
+
+  /**
+  * @brief Remembers the hash for the package, replacing any previous entry
+  */
+  void Store(const std::string& packagePath, PackageFingerprint::Algorithm algorithm, Manifest manifest, const std::string& hash);
+
+  /**
+  * @brief Writes the database if anything was stored since it was last written
+  */
+  void Save();
+}
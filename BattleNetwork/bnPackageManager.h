@@ -5,6 +5,8 @@
 #include "bnResourceHandle.h"
 #include "bnScriptResourceManager.h"
 #include "bnSolHelpers.h"
+#include "bnPackageFingerprint.h"
+#include "bnPackageFingerprintCache.h"
 #include "stx/string.h"
 #include "stx/result.h"
 #include "stx/tuple.h"
@@ -169,6 +171,36 @@ class PackageManager {
     template<typename ScriptedDataType>
     stx::result_t<std::string> LoadPackageFromZip(const std::string& path);
 
+    /**
+    * @brief Runs the package scripts at path and returns the package without committing it
+    *
+    * LoadPackageFromDisk() is ParsePackage(), HashPackage() and CommitPackage() in that order.
+    * They are separate so the file work in HashPackage() can be done on other threads.
+    * ParsePackage() and CommitPackage() must run on the thread loading this package manager.
+    */
+    template<typename ScriptedDataType>
+    stx::result_t<MetaClass*> ParsePackage(const std::string& path);
+
+    /**
+    * @brief Returns the PackageFingerprint of the package folder. Safe to call from any thread.
+    *
+    * If no file in the folder changed since the last time it was hashed, the stored hash
+    * from PackageFingerprintCache is returned without reading the files.
+    */
+    static stx::result_t<std::string> HashPackage(const std::string& filepath);
+
+    /**
+    * @brief Extracts a package .zip next to itself. Safe to call from any thread.
+    * @return path to the extracted folder
+    */
+    static stx::result_t<std::string> ExtractPackage(const std::string& path);
+
+    /**
+    * @brief Sets the fingerprint and commits a package from ParsePackage(). Deletes the package on failure.
+    * @return the package ID
+    */
+    stx::result_t<std::string> CommitPackage(MetaClass* package, const std::string& fingerprint);
+
     /**
     * @brief Get the size of the package list
     * @return const unsigned size
@@ -207,6 +239,12 @@ class PackageManager {
 template<typename MetaClass>
 void PackageManager<MetaClass>::LoadAllPackages(std::atomic<int>& progress)
 {
+#ifdef BN_MOD_SUPPORT
+  // some packages run their scripts here and other categories may be loading on other threads
+  ResourceHandle handle;
+  ScriptResourceManager::LoadingLock scriptLock(handle.Scripts());
+#endif
+
   for (auto& [key, entry] : packages) {
     entry->OnMetaParsed();
 
@@ -219,6 +257,27 @@ void PackageManager<MetaClass>::LoadAllPackages(std::atomic<int>& progress)
 template<typename MetaClass>
 template<typename ScriptedDataType>
 stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromDisk(const std::string& path)
+{
+  stx::result_t<MetaClass*> parsed = this->ParsePackage<ScriptedDataType>(path);
+
+  if (parsed.is_error()) {
+    return stx::error<std::string>(parsed.error_cstr());
+  }
+
+  MetaClass* packageClass = parsed.value();
+  stx::result_t<std::string> hashed = HashPackage(packageClass->GetFilePath());
+
+  if (hashed.is_error()) {
+    delete packageClass;
+    return stx::error<std::string>(hashed.error_cstr());
+  }
+
+  return this->CommitPackage(packageClass, hashed.value());
+}
+
+template<typename MetaClass>
+template<typename ScriptedDataType>
+stx::result_t<MetaClass*> PackageManager<MetaClass>::ParsePackage(const std::string& path)
 {
 #if defined(BN_MOD_SUPPORT) && !defined(__APPLE__)
   ResourceHandle handle;
@@ -229,71 +288,98 @@ stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromDisk(const
 
   std::string packageName = modpath.filename().generic_string();
 
-  stx::result_t<sol::state*> res = handle.Scripts().LoadScript(namespaceId, modpath);
+  // packages are often parsed on the loading thread, keep the frame thread from collecting lua garbage meanwhile
+  ScriptResourceManager::LoadingLock scriptLock(handle.Scripts());
 
-  if (!res.is_error()) {
-    sol::state& state = *res.value();
-    packageClass = this->CreatePackage<ScriptedDataType>(std::ref(state));
+  stx::result_t<ScriptPackage*> res = handle.Scripts().LoadScript(namespaceId, modpath);
 
-    //  Run all "includes" first
-    if (state["package_requires_scripts"].valid()) {
-      stx::result_t<sol::object> includesResult = CallLuaFunction(state, "package_requires_scripts");
+  if (res.is_error()) {
+    return stx::error<MetaClass*>(res.error_cstr());
+  }
 
-      if (includesResult.is_error()) {
-        delete packageClass;
-        std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + includesResult.error_cstr();
-        return stx::error<std::string>(msg);
-      }
-    }
+  ScriptPackage& scriptPackage = *res.value();
+  sol::table& script = scriptPackage.environment;
+  packageClass = this->CreatePackage<ScriptedDataType>(std::ref(script));
 
-    // todo: use a ScopedWrapper
-    stx::result_t<sol::object> initResult = CallLuaFunction(state, "package_init", packageClass);
+  // the engine needs to know which package is running its init functions
+  ScriptResourceManager::LoadingScope scope(handle.Scripts(), scriptPackage);
 
-    if (initResult.is_error()) {
+  //  Run all "includes" first
+  if (script["package_requires_scripts"].valid()) {
+    stx::result_t<sol::object> includesResult = CallLuaFunction(script, "package_requires_scripts");
+
+    if (includesResult.is_error()) {
       delete packageClass;
-      std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + initResult.error_cstr();
-      return stx::error<std::string>(msg);
+      std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + includesResult.error_cstr();
+      return stx::error<MetaClass*>(msg);
     }
+  }
 
-    packageClass->OnMetaParsed();
+  // todo: use a ScopedWrapper
+  stx::result_t<sol::object> initResult = CallLuaFunction(script, "package_init", packageClass);
 
-    std::string file_path = modpath.generic_string();
-    packageClass->SetFilePath(file_path);
+  if (initResult.is_error()) {
+    delete packageClass;
+    std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + initResult.error_cstr();
+    return stx::error<MetaClass*>(msg);
+  }
 
-    stx::result_t<bool> zip_result = stx::zip(file_path, file_path + ".zip");
-    if (zip_result.is_error()) {
-      delete packageClass;
-      std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + zip_result.error_cstr();
-      return stx::error<std::string>(msg);
-    }
+  packageClass->OnMetaParsed();
+  packageClass->SetFilePath(modpath.generic_string());
 
-    stx::result_t<std::string> md5_result = stx::generate_md5_from_file(file_path + ".zip");
-    if (md5_result.is_error()) {
-      delete packageClass;
-      std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + md5_result.error_cstr();
-      return stx::error<std::string>(msg);
-    }
-    else {
-      packageClass->SetPackageFingerprint(md5_result.value());
-    }
+  return stx::ok<MetaClass*>(packageClass);
+#else
+  return stx::error<MetaClass*>("std::filesystem not supported");
+#endif
+}
 
-    if (stx::result_t<bool> commit_result = this->Commit(packageClass); commit_result.is_error()) {
-      delete packageClass;
-      std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + commit_result.error_cstr();
-      return stx::error<std::string>(msg);
+template<typename MetaClass>
+stx::result_t<std::string> PackageManager<MetaClass>::HashPackage(const std::string& file_path)
+{
+  std::string packageName = std::filesystem::path(file_path).filename().generic_string();
+  std::string cacheKey = std::filesystem::absolute(file_path).generic_string();
+
+  PackageFingerprint::Algorithm algorithm = PackageFingerprint::GetAlgorithm();
+
+  // skip hashing when no file in the package changed since it was last hashed
+  std::optional<PackageFingerprintCache::Manifest> manifest = PackageFingerprintCache::ReadManifest(file_path);
+
+  if (manifest) {
+    if (std::optional<std::string> hash = PackageFingerprintCache::Find(cacheKey, algorithm, *manifest)) {
+      return stx::ok(*hash);
     }
   }
-  else {
-    return stx::error<std::string>(res.error_cstr());
+
+  stx::result_t<std::string> hash_result = PackageFingerprint::Hash(file_path, algorithm);
+  if (hash_result.is_error()) {
+    std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + hash_result.error_cstr();
+    return stx::error<std::string>(msg);
+  }
+
+  if (manifest) {
+    PackageFingerprintCache::Store(cacheKey, algorithm, std::move(*manifest), hash_result.value());
+  }
+
+  return hash_result;
+}
+
+template<typename MetaClass>
+stx::result_t<std::string> PackageManager<MetaClass>::CommitPackage(MetaClass* packageClass, const std::string& fingerprint)
+{
+  packageClass->SetPackageFingerprint(fingerprint);
+
+  if (stx::result_t<bool> commit_result = this->Commit(packageClass); commit_result.is_error()) {
+    std::string packageName = std::filesystem::path(packageClass->GetFilePath()).filename().generic_string();
+    delete packageClass;
+    std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + commit_result.error_cstr();
+    return stx::error<std::string>(msg);
   }
-#endif
 
   return stx::ok(packageClass->GetPackageID());
 }
 
 template<typename MetaClass>
-template<typename ScriptedDataType>
-stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromZip(const std::string& path)
+stx::result_t<std::string> PackageManager<MetaClass>::ExtractPackage(const std::string& path)
 {
 #if defined(BN_MOD_SUPPORT) && !defined(__APPLE__)
   std::filesystem::path absolute = std::filesystem::absolute(path);
@@ -302,7 +388,9 @@ stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromZip(const s
   std::string file_str = file.generic_string();
   size_t pos = file_str.find(".zip", 0);
 
-  if (pos == std::string::npos) stx::error<bool>("Invalid zip file");
+  if (pos == std::string::npos) {
+    return stx::error<std::string>("Invalid zip file");
+  }
 
   file_str = file_str.substr(0, pos);
 
@@ -314,13 +402,26 @@ stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromZip(const s
   if (result.is_error()) {
     return stx::error<std::string>(result.error_cstr());
   }
-  
-  return this->LoadPackageFromDisk<ScriptedDataType>(extracted_path);
-#elif
+
+  return stx::ok(extracted_path);
+#else
   return stx::error<std::string>("std::filesystem not supported");
 #endif
 }
 
+template<typename MetaClass>
+template<typename ScriptedDataType>
+stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromZip(const std::string& path)
+{
+  stx::result_t<std::string> extracted = ExtractPackage(path);
+
+  if (extracted.is_error()) {
+    return extracted;
+  }
+
+  return this->LoadPackageFromDisk<ScriptedDataType>(extracted.value());
+}
+
 /**
  * @brief Sets the deferred type constructor for T
  *
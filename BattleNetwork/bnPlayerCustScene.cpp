@@ -85,7 +85,9 @@ PlayerCustScene::PlayerCustScene(swoosh::ActivityController& controller, const s
   compile_item = load_audio("resources/sfx/compile_item.ogg");
 
   auto load_texture = [this](const std::string& path) {
-    return Textures().LoadFromFile(path);
+    std::shared_ptr<sf::Texture> texture = Textures().LoadFromFile(path);
+    spriteTextures.push_back(texture);
+    return texture;
   };
 
   cursorTexture = load_texture("resources/ui/textbox_cursor.png");
@@ -159,6 +159,7 @@ private:
   std::shared_ptr<sf::Texture> cursorTexture, miniblocksTexture, disabledBlockTexture;
   std::vector<std::shared_ptr<sf::Texture>> blockTextures;
   std::shared_ptr<sf::Texture> bgTex;
+  std::vector<std::shared_ptr<sf::Texture>> spriteTextures; //!< keeps textures alive for the sprites above
   std::shared_ptr<sf::SoundBuffer> compile_start, compile_complete, compile_no_item, compile_item;
   std::vector<Piece*> pieces;
   std::map<Piece*, size_t> centerHash;
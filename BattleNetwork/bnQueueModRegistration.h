@@ -1,14 +1,109 @@
 /*! \file bnQueueModRegistration.h */
-/*! \brief This function hooks into the loading phase and loads extra content */
+/*! \brief This function hooks into the loading phase and loads extra content
+ *
+ * Packages are installed in stages. Extracting zips and zipping + hashing folders
+ * run on a pool of worker threads. Package scripts and commits run on the loading thread
+ * in the order packages were found, so package IDs and conflict errors come out
+ * the same as loading one package at a time.
+ */
 
 #pragma once
+#include "bnPackageFingerprintCache.h"
+
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 // TODO: mac os < 10.5 file system support...
 #ifndef __APPLE__
 #include <filesystem>
-#endif 
+#endif
+
+namespace ModRegistration {
+  /*! \brief Timings for one call to QueueModRegistration */
+  struct Stats {
+    std::string category;
+    unsigned workers{};
+    size_t packages{}; //!< successfully installed
+    size_t failures{};
+    double extractSeconds{};
+    double parseSeconds{};
+    double hashSeconds{};
+    double commitSeconds{};
+    double totalSeconds{};
+  };
+
+  inline std::atomic<unsigned> workerCount{ 0 };
+  inline std::mutex statsMutex;
+  inline std::vector<Stats> stats;
+
+  /**
+  * @brief Sets how many threads install packages
+  * @param count 0 uses one per hardware thread, 1 installs everything on the loading thread
+  */
+  inline void SetWorkerCount(unsigned count) {
+    workerCount = count;
+  }
+
+  inline unsigned GetWorkerCount() {
+    unsigned count = workerCount;
+
+    if (count == 0) {
+      count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    return count;
+  }
+
+  /**
+  * @brief Timings of every category loaded so far, in the order they finished
+  */
+  inline std::vector<Stats> GetStats() {
+    std::scoped_lock lock(statsMutex);
+    return stats;
+  }
+
+  /**
+  * @brief Calls fn(i) for every i in [0, count) across the worker threads, including the calling thread
+  */
+  template<typename Fn>
+  inline void ParallelFor(size_t count, Fn&& fn) {
+    size_t workers = std::min<size_t>(GetWorkerCount(), count);
+
+    if (workers <= 1) {
+      for (size_t i = 0; i < count; i++) {
+        fn(i);
+      }
+
+      return;
+    }
+
+    std::atomic<size_t> next{ 0 };
+
+    auto work = [&] {
+      for (size_t i = next++; i < count; i = next++) {
+        fn(i);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+
+    for (size_t i = 1; i < workers; i++) {
+      threads.emplace_back(work);
+    }
+
+    work();
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+}
 
 template<typename PackageManagerT, typename ScriptedResourceT>
 static inline stx::result_t<bool> InstallMod(PackageManagerT& packageManager, const std::string& fullModPath) {
@@ -24,7 +119,29 @@ static inline stx::result_t<bool> InstallMod(PackageManagerT& packageManager, co
 template<typename PackageManagerT, typename ScriptedResourceT>
 static inline void QueueModRegistration(PackageManagerT& packageManager, const char* modPath, const char* modCategory) {
 #if defined(BN_MOD_SUPPORT) && !defined(__APPLE__)
+  using MetaClass = typename PackageManagerT::MetaClass_t;
+  using Clock = std::chrono::steady_clock;
+
+  auto secondsSince = [](Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+
+  struct Job {
+    std::string path; //!< folder to install, for zips this is set once extracted
+    std::string zipPath;
+    MetaClass* package{ nullptr };
+    std::string fingerprint;
+    std::string error;
+  };
+
+  ModRegistration::Stats stats;
+  stats.category = modCategory;
+  stats.workers = ModRegistration::GetWorkerCount();
+
+  Clock::time_point start = Clock::now();
+
   std::map<std::string, bool> ignoreList;
+  std::vector<Job> jobs;
   std::vector<std::string> zipList;
 
   std::filesystem::create_directories(modPath);
@@ -35,27 +152,21 @@ static inline void QueueModRegistration(PackageManagerT& packageManager, const c
     if (ignoreList.find(full_path) != ignoreList.end())
       continue;
 
-    // ignore readmes and text files 
+    // ignore readmes and text files
     if (size_t pos = full_path.find(".txt"); pos != std::string::npos)
       continue;
     if (size_t pos = full_path.find(".md"); pos != std::string::npos)
       continue;
 
-    try {
-      if (size_t pos = full_path.find(".zip"); pos == std::string::npos) {
-        ignoreList[full_path] = true;
-        ignoreList[full_path + ".zip"] = true;
+    if (size_t pos = full_path.find(".zip"); pos == std::string::npos) {
+      ignoreList[full_path] = true;
+      ignoreList[full_path + ".zip"] = true;
 
-        if (auto res = InstallMod<PackageManagerT, ScriptedResourceT>(packageManager, full_path); res.is_error()) {
-          throw std::runtime_error(res.error_cstr());
-        }
-      }
-      else {
-        zipList.push_back(full_path);
-      }
+      Job& job = jobs.emplace_back();
+      job.path = full_path;
     }
-    catch (std::runtime_error& e) {
-      Logger::Logf(LogLevel::critical, "[%s] extracted package error: %s", modCategory, e.what());
+    else {
+      zipList.push_back(full_path);
     }
   }
 
@@ -64,14 +175,129 @@ static inline void QueueModRegistration(PackageManagerT& packageManager, const c
     if (ignoreList.find(path) != ignoreList.end())
       continue;
 
+    Job& job = jobs.emplace_back();
+    job.zipPath = path;
+  }
+
+  // extract zips
+  Clock::time_point stageStart = Clock::now();
+
+  ModRegistration::ParallelFor(jobs.size(), [&jobs](size_t i) {
+    Job& job = jobs[i];
+
+    if (job.zipPath.empty()) return;
+
     try {
-      if (auto res = packageManager.template LoadPackageFromZip<ScriptedResourceT>(path); res.is_error()) {
-        throw std::runtime_error(res.error_cstr());
+      stx::result_t<std::string> res = PackageManagerT::ExtractPackage(job.zipPath);
+
+      if (res.is_error()) {
+        job.error = res.error_cstr();
+        return;
       }
+
+      job.path = res.value();
+    }
+    catch (std::exception& e) {
+      job.error = e.what();
+    }
+  });
+
+  stats.extractSeconds = secondsSince(stageStart);
+
+  // scripts share the script manager, run them in order on this thread
+  stageStart = Clock::now();
+
+  for (Job& job : jobs) {
+    if (!job.error.empty()) continue;
+
+    try {
+      stx::result_t<MetaClass*> res = packageManager.template ParsePackage<ScriptedResourceT>(job.path);
+
+      if (res.is_error()) {
+        job.error = res.error_cstr();
+        continue;
+      }
+
+      job.package = res.value();
     }
     catch (std::runtime_error& e) {
-      Logger::Logf(LogLevel::critical, "[%s] .zip package error %s", modCategory, e.what());
+      job.error = e.what();
+    }
+  }
+
+  stats.parseSeconds = secondsSince(stageStart);
+
+  // zip and hash
+  stageStart = Clock::now();
+
+  ModRegistration::ParallelFor(jobs.size(), [&jobs](size_t i) {
+    Job& job = jobs[i];
+
+    if (!job.package) return;
+
+    try {
+      stx::result_t<std::string> res = PackageManagerT::HashPackage(job.package->GetFilePath());
+
+      if (res.is_error()) {
+        job.error = res.error_cstr();
+        return;
+      }
+
+      job.fingerprint = res.value();
+    }
+    catch (std::exception& e) {
+      job.error = e.what();
+    }
+  });
+
+  stats.hashSeconds = secondsSince(stageStart);
+
+  // commit in the order the packages were found
+  stageStart = Clock::now();
+
+  for (Job& job : jobs) {
+    if (job.error.empty()) {
+      try {
+        stx::result_t<std::string> res = packageManager.CommitPackage(job.package, job.fingerprint);
+        job.package = nullptr;
+
+        if (res.is_error()) {
+          job.error = res.error_cstr();
+        }
+      }
+      catch (std::runtime_error& e) {
+        job.error = e.what();
+      }
+    }
+    else {
+      delete job.package;
+      job.package = nullptr;
+    }
+
+    if (job.error.empty()) {
+      stats.packages++;
+      continue;
+    }
+
+    stats.failures++;
+
+    if (job.zipPath.empty()) {
+      Logger::Logf(LogLevel::critical, "[%s] extracted package error: %s", modCategory, job.error.c_str());
+    }
+    else {
+      Logger::Logf(LogLevel::critical, "[%s] .zip package error %s", modCategory, job.error.c_str());
     }
   }
+
+  PackageFingerprintCache::Save();
+
+  stats.commitSeconds = secondsSince(stageStart);
+  stats.totalSeconds = secondsSince(start);
+
+  Logger::Logf(LogLevel::debug, "[%s] installed %i packages in %f secs with %i workers",
+    modCategory, static_cast<int>(stats.packages), stats.totalSeconds, static_cast<int>(stats.workers));
+
+  std::scoped_lock lock(ModRegistration::statsMutex);
+  ModRegistration::stats.push_back(stats);
 #endif
-}
\ No newline at end of file
+}
@@ -0,0 +1,170 @@
+#include "bnRenderQueue.h"
+#include "bnSpriteProxyNode.h"
+#include "bnTextureAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+void RenderQueue::SetAtlas(const TextureAtlas* atlas) {
+  RenderQueue::atlas = atlas;
+}
+
+void RenderQueue::Submit(const sf::Sprite& sprite, const sf::RenderStates& states, int order) {
+  const sf::Texture* texture = sprite.getTexture();
+
+  if (!texture) return;
+
+  sf::Transform transform = states.transform * sprite.getTransform();
+  sf::IntRect rect = sprite.getTextureRect();
+  sf::Color color = sprite.getColor();
+
+  if (atlas && !texture->isRepeated()) {
+    std::optional<TextureAtlas::Region> region = atlas->Find(texture);
+
+    // rects reaching outside of the image would sample neighbors on the page
+    int minX = std::min(rect.left, rect.left + rect.width);
+    int minY = std::min(rect.top, rect.top + rect.height);
+    int maxX = std::max(rect.left, rect.left + rect.width);
+    int maxY = std::max(rect.top, rect.top + rect.height);
+
+    if (region && minX >= 0 && minY >= 0 && maxX <= region->rect.width && maxY <= region->rect.height) {
+      texture = region->page;
+      rect.left += region->rect.left;
+      rect.top += region->rect.top;
+    }
+  }
+
+  // same corners and texture coordinates sf::Sprite builds for itself
+  float width = static_cast<float>(std::abs(rect.width));
+  float height = static_cast<float>(std::abs(rect.height));
+  float left = static_cast<float>(rect.left);
+  float right = left + rect.width;
+  float top = static_cast<float>(rect.top);
+  float bottom = top + rect.height;
+
+  sf::Vertex corners[4] = {
+    sf::Vertex(transform.transformPoint(0.f, 0.f), color, { left, top }),
+    sf::Vertex(transform.transformPoint(0.f, height), color, { left, bottom }),
+    sf::Vertex(transform.transformPoint(width, 0.f), color, { right, top }),
+    sf::Vertex(transform.transformPoint(width, height), color, { right, bottom })
+  };
+
+  Item item;
+  item.order = order;
+  item.shader = states.shader;
+  item.texture = texture;
+  item.blendMode = states.blendMode;
+  item.firstVertex = vertices.size();
+  items.push_back(item);
+
+  // two triangles instead of a strip so quads can share one vertex array
+  vertices.push_back(corners[0]);
+  vertices.push_back(corners[1]);
+  vertices.push_back(corners[2]);
+  vertices.push_back(corners[2]);
+  vertices.push_back(corners[1]);
+  vertices.push_back(corners[3]);
+}
+
+int RenderQueue::Submit(const SpriteProxyNode& node, sf::RenderStates states, int order) {
+  if (node.IsHidden()) return order;
+
+  // mirrors SpriteProxyNode::draw()
+  states.transform *= node.getTransform();
+
+  sf::Shader* s = node.GetShader().Get();
+
+  if (s) {
+    states.shader = s;
+  }
+  else if (!node.IsUsingParentShader()) {
+    states.shader = nullptr;
+  }
+
+  node.SortChildNodes();
+
+  bool submittedSelf = false;
+
+  for (std::shared_ptr<SceneNode>& child : node.GetChildNodes()) {
+    if (!submittedSelf && child->GetLayer() < node.GetLayer()) {
+      Submit(node.getSpriteConst(), states, order++);
+      submittedSelf = true;
+    }
+
+    if (auto* proxy = dynamic_cast<SpriteProxyNode*>(child.get())) {
+      order = Submit(*proxy, states, order);
+      continue;
+    }
+
+    Item item;
+    item.order = order++;
+    item.drawable = child.get();
+    item.drawableStates = states;
+    items.push_back(item);
+  }
+
+  if (!submittedSelf) {
+    Submit(node.getSpriteConst(), states, order++);
+  }
+
+  return order;
+}
+
+bool RenderQueue::SameBatch(const Item& a, const Item& b) const {
+  return !a.drawable && !b.drawable
+    && a.shader == b.shader
+    && a.texture == b.texture
+    && a.blendMode == b.blendMode;
+}
+
+void RenderQueue::Flush(sf::RenderTarget& target) {
+  drawCalls = 0;
+
+  std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+    if (a.order != b.order) return a.order < b.order;
+    if (a.shader != b.shader) return std::less<const sf::Shader*>()(a.shader, b.shader);
+    return std::less<const sf::Texture*>()(a.texture, b.texture);
+  });
+
+  size_t i = 0;
+
+  while (i < items.size()) {
+    const Item& first = items[i];
+
+    if (first.drawable) {
+      target.draw(*first.drawable, first.drawableStates);
+      drawCalls++;
+      i++;
+      continue;
+    }
+
+    batch.clear();
+
+    size_t end = i;
+
+    for (; end < items.size() && SameBatch(first, items[end]); end++) {
+      const sf::Vertex* quad = &vertices[items[end].firstVertex];
+
+      for (size_t v = 0; v < 6; v++) {
+        batch.append(quad[v]);
+      }
+    }
+
+    sf::RenderStates batchStates;
+    batchStates.blendMode = first.blendMode;
+    batchStates.shader = first.shader;
+    batchStates.texture = first.texture;
+
+    target.draw(batch, batchStates);
+    drawCalls++;
+    i = end;
+  }
+
+  items.clear();
+  vertices.clear();
+}
+
+size_t RenderQueue::GetDrawCallCount() const {
+  return drawCalls;
+}
@@ -0,0 +1,74 @@
+/*! \brief Collects sprites during a frame and draws them in as few batches as possible
+ *
+ * Sprites are submitted with an order. When flushed, items are sorted by
+ * (order, shader, texture) and consecutive sprites sharing render states are
+ * drawn with a single vertex array.
+ *
+ * Items with the same order are assumed not to overlap, they may be drawn in any order.
+ * The shader is captured when submitted. Nodes sharing an sf::Shader in the same batch
+ * must not need different uniform values, so this is meant for tiles and other
+ * sprites without per-sprite uniforms.
+ *
+ * If an atlas is set, sprites whose texture was packed are drawn from the atlas page instead
+ * so sprites loaded from different images can share a batch.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class SpriteProxyNode;
+class TextureAtlas;
+
+class RenderQueue {
+public:
+  /**
+   * @brief Look up packed textures in atlas when submitting sprites
+   * @param atlas can be nullptr
+   */
+  void SetAtlas(const TextureAtlas* atlas);
+
+  /**
+   * @brief Submits the sprite with states, the sprite can change after this returns
+   */
+  void Submit(const sf::Sprite& sprite, const sf::RenderStates& states, int order);
+
+  /**
+   * @brief Submits a node and its children in the same order SpriteProxyNode::draw() would draw them
+   * @param order order of the first sprite drawn, every following sprite in the node uses the next order
+   * @return the order after the last sprite in the node
+   *
+   * Children that are not sprite nodes cannot be batched and are drawn by themselves.
+   * They must stay alive until Flush()
+   */
+  int Submit(const SpriteProxyNode& node, sf::RenderStates states, int order = 0);
+
+  /**
+   * @brief Draws and clears everything submitted since the last flush
+   */
+  void Flush(sf::RenderTarget& target);
+
+  /**
+   * @brief Number of draw calls made by the last Flush()
+   */
+  size_t GetDrawCallCount() const;
+
+private:
+  struct Item {
+    int order{};
+    const sf::Shader* shader{ nullptr };
+    const sf::Texture* texture{ nullptr };
+    sf::BlendMode blendMode;
+    size_t firstVertex{}; //!< 6 vertices in `vertices` for sprites
+    const sf::Drawable* drawable{ nullptr }; //!< non-null for items that are drawn by themselves
+    sf::RenderStates drawableStates;
+  };
+
+  bool SameBatch(const Item& a, const Item& b) const;
+
+  const TextureAtlas* atlas{ nullptr };
+  std::vector<Item> items;
+  std::vector<sf::Vertex> vertices; //!< transformed triangles for every submitted sprite
+  sf::VertexArray batch{ sf::Triangles };
+  size_t drawCalls{};
+};
@@ -9,7 +9,13 @@ SceneNode::~SceneNode() {
 }
 
 void SceneNode::SetLayer(int layer) {
+  if (SceneNode::layer == layer) return;
+
   SceneNode::layer = layer;
+
+  if (parent) {
+    parent->childNodesSorted = false;
+  }
 }
 
 const int SceneNode::GetLayer() const {
@@ -35,7 +41,7 @@ const bool SceneNode::IsVisible() const {
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
   if (!show) return;
 
-  std::sort(childNodes.begin(), childNodes.end(), [](std::shared_ptr<SceneNode>& a, std::shared_ptr<SceneNode>& b) { return (a->GetLayer() > b->GetLayer()); });
+  SortChildNodes();
 
   // draw its children
   for (auto& childNode : childNodes) {
@@ -49,8 +55,15 @@ void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
   }
 }
 
+void SceneNode::SortChildNodes() const {
+  if (childNodesSorted) return;
+
+  std::stable_sort(childNodes.begin(), childNodes.end(), [](const std::shared_ptr<SceneNode>& a, const std::shared_ptr<SceneNode>& b) { return (a->GetLayer() > b->GetLayer()); });
+  childNodesSorted = true;
+}
+
 void SceneNode::AddNode(std::shared_ptr<SceneNode> child) { 
-  if (child == nullptr) return;  child->parent = this; childNodes.push_back(child); 
+  if (child == nullptr) return;  child->parent = this; childNodes.push_back(child); childNodesSorted = false;
 }
 
 void SceneNode::RemoveNode(std::shared_ptr<SceneNode> find) {
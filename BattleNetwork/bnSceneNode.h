@@ -16,6 +16,7 @@ class SceneNode : public sf::Transformable, public sf::Drawable {
 protected:
   std::set<std::string> tags; /*!< Tags to lookup nodes by*/
   mutable std::vector<std::shared_ptr<SceneNode>> childNodes; /*!< List of all children */
+  mutable bool childNodesSorted{ true }; /*!< False when a child was added or changed layers since the last sort */
   SceneNode* parent; /*!< The node this node is a child of */
   bool show; /*!< Flag to hide or display a scene node and its children */
   int layer; /*!< Draw order of this node */
@@ -68,6 +69,13 @@ public:
    */
   const bool IsVisible() const;
 
+  /**
+   * @brief Sorts childNodes by descending layer if a child was added or changed layers
+   *
+   * The sort is stable so children on the same layer keep the order they were added in
+   */
+  void SortChildNodes() const;
+
   /**
    * @brief Sort the nodes by Ascending Z Order and draw the nodes
    * @param target
@@ -3,6 +3,8 @@
 #include <vector>
 #include <functional>
 #include <cstdlib>
+#include <algorithm>
+#include <chrono>
 #include "bnScriptResourceManager.h"
 #include "bnAudioResourceManager.h"
 #include "bnTextureResourceManager.h"
@@ -13,6 +15,8 @@
 #include "bnMobPackageManager.h"
 #include "bnBlockPackageManager.h"
 #include "bnLuaLibraryPackageManager.h"
+#include "bnLuaBytecodeCache.h"
+#include "bnLuaProfiler.h"
 
 #include "bnCard.h"
 #include "bnEntity.h"
@@ -87,11 +91,8 @@ std::list<OverrideFrame> CreateFrameData(sol::lua_table table)
   return frames;
 }
 
-void ScriptResourceManager::SetSystemFunctions(ScriptPackage& scriptPackage)
+void ScriptResourceManager::SetSystemFunctions(sol::state& state, const std::string& namespaceId, ScriptPackage* owner)
 {
-  sol::state& state = *scriptPackage.state;
-  const std::string& namespaceId = scriptPackage.address.namespaceId;
-
   state.open_libraries(sol::lib::base, sol::lib::math, sol::lib::table);
 
   state["math"]["randomseed"] = []{
@@ -114,14 +115,22 @@ void ScriptResourceManager::SetSystemFunctions(ScriptPackage& scriptPackage)
   // 'include()' in Lua is intended to load a LIBRARY file of Lua code into the current lua state.
   // Currently only loads library files included in the SAME directory as the script file.
   // Has to capture a pointer to sol::state, the copy constructor was deleted, cannot capture a copy to reference.
+  // The library runs in a child of the caller's environment so shared runtimes keep packages apart.
   state.set_function("include",
-    [this, &state, &namespaceId, &scriptPackage](const std::string& fileName) -> sol::object {
+    [this, &state, &namespaceId, owner](sol::this_environment callerEnvironment, const std::string& fileName) -> sol::object {
       std::string scriptPath;
 
+      // only load-time includes can be traced back to a package in a shared runtime
+      ScriptPackage* scriptPackage = owner;
+
+      if (!scriptPackage && !loadingPackages.empty()) {
+        scriptPackage = loadingPackages.back();
+      }
+
       // Prefer using the shared libraries if possible.
       // i.e. ones that were present in "mods/libs/"
       // make sure it was required by checking dependencies as well
-      if(std::find(scriptPackage.dependencies.begin(), scriptPackage.dependencies.end(), scriptPath) != scriptPackage.dependencies.end())
+      if(scriptPackage && std::find(scriptPackage->dependencies.begin(), scriptPackage->dependencies.end(), scriptPath) != scriptPackage->dependencies.end())
       {
         Logger::Logf(LogLevel::debug, "Including shared library: %s", fileName.c_str());
 
@@ -141,10 +150,25 @@ void ScriptResourceManager::SetSystemFunctions(ScriptPackage& scriptPackage)
         scriptPath = parentFolder + "/" + fileName;
       }
 
-      sol::environment env(state, sol::create, state.globals());
+      sol::table parentEnvironment = state.globals();
+
+      if (callerEnvironment.env) {
+        parentEnvironment = *callerEnvironment.env;
+      }
+
+      sol::environment env(state, sol::create, parentEnvironment);
       env["_folderpath"] = std::filesystem::path(scriptPath).parent_path().string() + "/";
 
-      sol::protected_function_result result = state.do_file(scriptPath, env);
+      sol::load_result loaded = LoadScriptFile(state, scriptPath, env);
+
+      if (!loaded.valid()) {
+        sol::error error = loaded;
+        throw std::runtime_error(error.what());
+      }
+
+      sol::protected_function script = loaded;
+
+      sol::protected_function_result result = script();
 
       if (!result.valid()) {
         sol::error error = result;
@@ -156,10 +180,31 @@ void ScriptResourceManager::SetSystemFunctions(ScriptPackage& scriptPackage)
   );
 }
 
-void ScriptResourceManager::SetModPathVariable( sol::state& state, const std::filesystem::path& modDirectory )
+sol::load_result ScriptResourceManager::LoadScriptFile(sol::state& state, const std::string& path, const sol::table& environment)
 {
-  state["_modpath"] = modDirectory.generic_string() + "/";
-  state["_folderpath"] = modDirectory.generic_string() + "/";
+  lua_State* L = state.lua_state();
+  sol::load_status status = static_cast<sol::load_status>(LuaBytecodeCache::LoadFile(L, path));
+
+  if (status == sol::load_status::ok) {
+    // a main chunk's only upvalue is _ENV
+    environment.push();
+#if LUA_VERSION_NUM >= 502
+    if (!lua_setupvalue(L, -2, 1)) {
+      lua_pop(L, 1);
+    }
+#else
+    lua_setfenv(L, -2);
+#endif
+  }
+
+  // same as sol::state::load_file()
+  return sol::load_result(L, sol::absolute_index(L, -1), 1, 1, status);
+}
+
+void ScriptResourceManager::SetModPathVariable( sol::table& environment, const std::filesystem::path& modDirectory )
+{
+  environment["_modpath"] = modDirectory.generic_string() + "/";
+  environment["_folderpath"] = modDirectory.generic_string() + "/";
 }
 
 // Free Function provided to a number of Lua types that will print an error message when attempting to access a key that does not exist.
@@ -220,10 +265,8 @@ std::string ScriptResourceManager::GetCurrentLine( lua_State* L )
   return std::string(ar.source) + ":" + std::to_string(ar.currentline);
 }
 
-void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
+void ScriptResourceManager::ConfigureEnvironment(sol::state& state, const std::string& namespaceId, ScriptPackage* owner) {
 
-  sol::state& state = *scriptPackage.state;
-  const std::string& namespaceId = scriptPackage.address.namespaceId;
   sol::table battle_namespace = state.create_table("Battle");
   sol::table overworld_namespace = state.create_table("Overworld");
   sol::table engine_namespace = state.create_table("Engine");
@@ -253,7 +296,9 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
   DefineScriptedCardActionUserType(namespaceId, this, battle_namespace);
   DefineDefenseRuleUserTypes(state, battle_namespace);
 
-  auto SetPackageId = [this, &scriptPackage] (const std::string& packageId) {
+  auto SetPackageId = [this, owner] (const std::string& packageId) {
+    ScriptPackage& scriptPackage = GetCallingPackage(owner);
+
     if (packageId.empty()) {
       throw std::runtime_error("Package id is blank!");
     }
@@ -269,6 +314,10 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
     }
 
     address2package[scriptPackage.address] = &scriptPackage;
+
+    if (owner) {
+      LuaProfiler::SetName(owner->state->lua_state(), packageId);
+    }
   };
 
   DefineCardMetaUserTypes(this, state, battle_namespace, SetPackageId);
@@ -456,38 +505,38 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
   );
 
   engine_namespace.set_function("define_character",
-    [this, &scriptPackage](const std::string& fqn, const std::string& path) {
-      DefineSubpackage(scriptPackage, ScriptPackageType::character, fqn, path);
+    [this, owner](const std::string& fqn, const std::string& path) {
+      DefineSubpackage(GetCallingPackage(owner), ScriptPackageType::character, fqn, path);
     }
   );
 
   engine_namespace.set_function("requires_character",
-    [this, &scriptPackage, &namespaceId](const std::string& fqn) {
-      scriptPackage.dependencies.push_back(fqn);
+    [this, owner](const std::string& fqn) {
+      GetCallingPackage(owner).dependencies.push_back(fqn);
     }
   );
 
   engine_namespace.set_function("define_card",
-    [this, &scriptPackage](const std::string& fqn, const std::string& path) {
-      DefineSubpackage(scriptPackage, ScriptPackageType::card, fqn, path);
+    [this, owner](const std::string& fqn, const std::string& path) {
+      DefineSubpackage(GetCallingPackage(owner), ScriptPackageType::card, fqn, path);
     }
   );
 
   engine_namespace.set_function("requires_card",
-    [this, &scriptPackage, &namespaceId](const std::string& fqn) {
-      scriptPackage.dependencies.push_back(fqn);
+    [this, owner](const std::string& fqn) {
+      GetCallingPackage(owner).dependencies.push_back(fqn);
     }
   );
 
   engine_namespace.set_function("define_library",
-    [this, &scriptPackage]( const std::string& fqn, const std::string& path ) {
-      DefineSubpackage(scriptPackage, ScriptPackageType::library, fqn, path);
+    [this, owner]( const std::string& fqn, const std::string& path ) {
+      DefineSubpackage(GetCallingPackage(owner), ScriptPackageType::library, fqn, path);
     }
   );
 
   engine_namespace.set_function("requires_library",
-    [this, &scriptPackage, &namespaceId](const std::string& fqn) {
-      scriptPackage.dependencies.push_back(fqn);
+    [this, owner](const std::string& fqn) {
+      GetCallingPackage(owner).dependencies.push_back(fqn);
     }
   );
 
@@ -697,57 +746,295 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
   state.set_function( "make_frame_data", &CreateFrameData );
 }
 
+ScriptResourceManager::LoadingScope::LoadingScope(ScriptResourceManager& manager, ScriptPackage& package) :
+  manager(manager)
+{
+  manager.loadingPackages.push_back(&package);
+}
+
+ScriptResourceManager::LoadingScope::~LoadingScope()
+{
+  manager.loadingPackages.pop_back();
+}
+
 ScriptResourceManager::~ScriptResourceManager()
 {
-  for (auto [state, scriptPackage] : state2package) {
-    delete state;
+  for (auto [scriptPackage, state] : package2state) {
+    ReleasePackageState(*scriptPackage);
     delete scriptPackage;
   }
 }
 
-stx::result_t<sol::state*> ScriptResourceManager::LoadScript(const std::string& namespaceId, const std::filesystem::path& modDirectory, ScriptPackageType type)
+void ScriptResourceManager::SetSharedRuntimes(bool enabled)
+{
+  useSharedRuntimes = enabled;
+}
+
+void ScriptResourceManager::SetGarbageCollectionBudget(double seconds)
+{
+  collectionBudget = std::max(0.0, seconds);
+}
+
+ScriptResourceManager::LoadingLock::LoadingLock(ScriptResourceManager& manager) :
+  lock(manager.loadingMutex)
+{
+  // frames cannot collect until this is released, lua collects as the loading scripts allocate
+  for (auto& [L, collector] : manager.collectors) {
+    if (!collector.stopped) continue;
+
+    lua_gc(L, LUA_GCRESTART, 0);
+    collector.stopped = false;
+  }
+}
+
+void ScriptResourceManager::ConfigureGarbageCollector(lua_State* L)
+{
+  if (collectionBudget <= 0) return;
+
+  // Lua's own collector runs until CollectGarbage() finishes the first cycle of this state, and again whenever frames fall behind or packages load.
+  // When it does, the cycle is still incremental and spread over the allocations that follow.
+  constexpr int PAUSE = 300; // % of memory after the last cycle that starts a new one
+  constexpr int STEP_MULTIPLIER = 200;
+  constexpr int STEP_SIZE = 10; // log2 of the bytes of work in a basic step, small steps stop close to the deadline
+
+#ifdef LUA_GCINC
+  lua_gc(L, LUA_GCINC, PAUSE, STEP_MULTIPLIER, STEP_SIZE);
+#else
+  lua_gc(L, LUA_GCSETPAUSE, PAUSE);
+  lua_gc(L, LUA_GCSETSTEPMUL, STEP_MULTIPLIER);
+#endif
+
+  Collector& collector = collectors[L];
+  collector.kbAfterCycle = lua_gc(L, LUA_GCCOUNT, 0);
+}
+
+void ScriptResourceManager::CollectGarbage(double idleSeconds)
+{
+  if (collectors.empty()) return;
+
+  // the loading thread restarted lua's own collectors when it took the lock, see LoadingLock
+  std::unique_lock lock(loadingMutex, std::try_to_lock);
+
+  if (!lock.owns_lock()) return;
+
+  // frames are not keeping up, let lua collect as scripts allocate until a cycle here finishes.
+  // checked for every state before the budget runs out, states that do not get a turn still grow
+  for (auto& [L, collector] : collectors) {
+    if (collector.stopped && lua_gc(L, LUA_GCCOUNT, 0) > collector.kbAfterCycle * 2) {
+      lua_gc(L, LUA_GCRESTART, 0);
+      collector.stopped = false;
+    }
+  }
+
+  double budget = std::min(collectionBudget, idleSeconds);
+
+  if (budget <= 0) return;
+
+  using clock = std::chrono::steady_clock;
+  clock::time_point start = clock::now();
+  clock::time_point deadline = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(budget));
+
+  // start after the state stepped last so every state gets a turn
+  auto it = collectors.upper_bound(lastCollected);
+  bool stepped = false;
+
+  for (size_t visited = 0; visited < collectors.size() && clock::now() < deadline; visited++, it++) {
+    if (it == collectors.end()) {
+      it = collectors.begin();
+    }
+
+    lua_State* L = it->first;
+    Collector& collector = it->second;
+
+    int kb = lua_gc(L, LUA_GCCOUNT, 0);
+
+    // lua's own collector can finish a cycle between our steps, less memory than our last cycle left means it did
+    if (kb < collector.kbAfterCycle) {
+      collector.kbAfterCycle = kb;
+      collector.collecting = false;
+    }
+
+    // only start a cycle once there is enough new memory for it to be worth it
+    if (!collector.collecting) {
+      int threshold = collector.kbAfterCycle + std::max(collector.kbAfterCycle / 4, 64);
+
+      if (kb < threshold) continue;
+
+      collector.collecting = true;
+    }
+
+    lastCollected = L;
+    stepped = true;
+
+    while (clock::now() < deadline) {
+      if (lua_gc(L, LUA_GCSTEP, 0)) {
+        collector.collecting = false;
+        collector.kbAfterCycle = lua_gc(L, LUA_GCCOUNT, 0);
+
+        // from here on frames do the collecting, scripts stop paying for it while they run
+        if (!collector.stopped) {
+          lua_gc(L, LUA_GCSTOP, 0);
+          collector.stopped = true;
+        }
+
+        break;
+      }
+    }
+  }
+
+  if (stepped) {
+    LuaProfiler::RecordCollection(std::chrono::duration<double>(clock::now() - start).count());
+  }
+}
+
+ScriptPackage& ScriptResourceManager::GetCallingPackage(ScriptPackage* owner)
+{
+  if (owner) {
+    return *owner;
+  }
+
+  if (loadingPackages.empty()) {
+    throw std::runtime_error("Packages can only be declared while they are loading");
+  }
+
+  return *loadingPackages.back();
+}
+
+sol::state& ScriptResourceManager::AcquireSharedRuntime(const std::string& namespaceId)
+{
+  SharedRuntime& runtime = sharedRuntimes[namespaceId];
+
+  if (!runtime.state) {
+    Logger::Logf(LogLevel::debug, "Creating shared lua runtime for partition %s", namespaceId.c_str());
+
+    runtime.namespaceId = namespaceId;
+    runtime.state = new sol::state;
+    LuaProfiler::Attach(runtime.state->lua_state(), namespaceId + " (shared)");
+    ConfigureGarbageCollector(runtime.state->lua_state());
+
+    SetSystemFunctions(*runtime.state, runtime.namespaceId, nullptr);
+    ConfigureEnvironment(*runtime.state, runtime.namespaceId, nullptr);
+
+    runtime.state->set_exception_handler(&::exception_handler);
+  }
+
+  runtime.packageCount++;
+  return *runtime.state;
+}
+
+void ScriptResourceManager::ReleasePackageState(ScriptPackage& package)
+{
+  // the environment references the state and must be released first
+  package.environment = sol::table();
+
+  for (auto it = sharedRuntimes.begin(); it != sharedRuntimes.end(); ++it) {
+    SharedRuntime& runtime = it->second;
+
+    if (runtime.state != package.state) continue;
+
+    if (--runtime.packageCount == 0) {
+      Logger::Logf(LogLevel::debug, "Closing shared lua runtime for partition %s", runtime.namespaceId.c_str());
+      lua_State* L = runtime.state->lua_state();
+      collectors.erase(L);
+      delete runtime.state;
+      LuaProfiler::Detach(L);
+      sharedRuntimes.erase(it);
+    }
+
+    package.state = nullptr;
+    return;
+  }
+
+  if (package.state) {
+    lua_State* L = package.state->lua_state();
+    collectors.erase(L);
+    delete package.state;
+    LuaProfiler::Detach(L);
+  }
+
+  package.state = nullptr;
+}
+
+stx::result_t<ScriptPackage*> ScriptResourceManager::LoadScript(const std::string& namespaceId, const std::filesystem::path& modDirectory, ScriptPackageType type)
 {
   auto entryPath = modDirectory / "entry.lua";
 
-  sol::state* lua = new sol::state;
-
-  // We must store package information for the proceeding configurations to work correctly
-  auto [it, _] = state2package.emplace(lua, new ScriptPackage());
-  ScriptPackage& scriptPackage = *it->second;
-  scriptPackage.state = lua;
-  scriptPackage.type = type;
-  scriptPackage.address.namespaceId = namespaceId;
-  scriptPackage.path = modDirectory.generic_string();
-
-  // Configure the scripts to run safely
-  SetModPathVariable(*lua, modDirectory);
-  SetSystemFunctions(scriptPackage);
-  ConfigureEnvironment(scriptPackage);
-
-  lua->set_exception_handler(&::exception_handler);
-  auto loadResult = lua->safe_script_file(entryPath.generic_string(), sol::script_pass_on_error);
-
-  if (!loadResult.valid()) {
-    sol::error loadError = loadResult;
-    std::string msg = "Failed to load package " + scriptPackage.address.packageId + ". Reason: " + loadError.what();
-    DropPackageData(lua);
-    loadResult.abandon();
-    return stx::error<sol::state*>(msg);
+  ScriptPackage* scriptPackage = new ScriptPackage();
+  scriptPackage->type = type;
+  scriptPackage->address.namespaceId = namespaceId;
+  scriptPackage->path = modDirectory.generic_string();
+
+  sol::state* lua = nullptr;
+
+  if (useSharedRuntimes) {
+    // engine types are already registered, the package only needs its own globals
+    lua = &AcquireSharedRuntime(namespaceId);
+    scriptPackage->state = lua;
+    scriptPackage->environment = sol::environment(*lua, sol::create, lua->globals());
+    package2state.emplace(scriptPackage, lua);
+  }
+  else {
+    lua = new sol::state;
+    scriptPackage->state = lua;
+    LuaProfiler::Attach(lua->lua_state(), modDirectory.filename().generic_string());
+    ConfigureGarbageCollector(lua->lua_state());
+
+    // We must store package information for the proceeding configurations to work correctly
+    package2state.emplace(scriptPackage, lua);
+
+    // Configure the scripts to run safely
+    SetSystemFunctions(*lua, scriptPackage->address.namespaceId, scriptPackage);
+    ConfigureEnvironment(*lua, scriptPackage->address.namespaceId, scriptPackage);
+
+    lua->set_exception_handler(&::exception_handler);
+    scriptPackage->environment = lua->globals();
   }
 
-  return stx::ok<sol::state*>(lua);
+  SetModPathVariable(scriptPackage->environment, modDirectory);
+
+  bool failed = false;
+  std::string error;
+
+  // lua objects must be released before the state is dropped
+  {
+    LoadingScope scope(*this, *scriptPackage);
+    sol::load_result loaded = LoadScriptFile(*lua, entryPath.generic_string(), scriptPackage->environment);
+
+    if (!loaded.valid()) {
+      sol::error loadError = loaded;
+      error = loadError.what();
+      failed = true;
+    }
+    else {
+      sol::protected_function entry = loaded;
+      sol::protected_function_result loadResult = entry();
+
+      if (!loadResult.valid()) {
+        sol::error loadError = loadResult;
+        error = loadError.what();
+        failed = true;
+      }
+    }
+  }
+
+  if (failed) {
+    std::string msg = "Failed to load package " + scriptPackage->address.packageId + ". Reason: " + error;
+    DropPackageData(scriptPackage);
+    return stx::error<ScriptPackage*>(msg);
+  }
+
+  return stx::ok<ScriptPackage*>(scriptPackage);
 }
 
-void ScriptResourceManager::DropPackageData(sol::state* state)
+void ScriptResourceManager::DropPackageData(ScriptPackage* package)
 {
-  auto stateIt = state2package.find(state);
+  auto stateIt = package2state.find(package);
 
-  if (stateIt == state2package.end()) {
+  if (stateIt == package2state.end()) {
     return;
   }
 
-  auto* package = stateIt->second;
-  state2package.erase(stateIt);
+  package2state.erase(stateIt);
 
   // drop subpackages
   for (auto& packageId : package->subpackages) {
@@ -764,7 +1051,7 @@ void ScriptResourceManager::DropPackageData(sol::state* state)
     Logger::Logf(LogLevel::debug, "Dropping unknown package in partition %s", package->address.namespaceId.c_str());
   }
 
-  delete state;
+  ReleasePackageState(*package);
   delete package;
 }
 
@@ -786,10 +1073,10 @@ void ScriptResourceManager::DropPackageData(const PackageAddress& addr)
     DropPackageData({ package->address.namespaceId, packageId });
   }
 
-  state2package.erase(package->state);
+  package2state.erase(package);
 
   // drop package
-  delete package->state;
+  ReleasePackageState(*package);
   delete package;
 }
 
@@ -824,9 +1111,13 @@ ScriptPackage* ScriptResourceManager::DefinePackage(ScriptPackageType type, cons
     throw std::runtime_error(res.error_cstr());
   }
 
-  auto& scriptPackage = state2package[res.value()];
+  ScriptPackage* scriptPackage = res.value();
   scriptPackage->address = addr;
   address2package[addr] = scriptPackage;
+
+  if (!useSharedRuntimes) {
+    LuaProfiler::SetName(scriptPackage->state->lua_state(), fqn);
+  }
   return scriptPackage;
 }
 
@@ -11,6 +11,7 @@
 #include <atomic>
 #include <filesystem>
 #include <list>
+#include <mutex>
 #include "stx/result.h"
 
 #ifdef __unix__
@@ -31,7 +32,8 @@ enum class ScriptPackageType : uint8_t {
 };
 
 struct ScriptPackage {
-  sol::state* state{ nullptr };
+  sol::state* state{ nullptr }; //!< owned by the package unless runtimes are shared
+  sol::table environment; //!< globals seen by the package scripts: the state's globals or the package's own _ENV in a shared runtime
   ScriptPackageType type;
   PackageAddress address;
   std::string path;
@@ -39,13 +41,59 @@ struct ScriptPackage {
   std::vector<std::string> dependencies;
 };
 
+/*! \brief Loads package scripts and owns the lua states they run in
+ *
+ * By default every package gets its own sol::state with every usertype defined in it.
+ * With shared runtimes enabled, packages in the same namespace share one sol::state
+ * whose bindings are defined once. Each package then runs in its own environment table
+ * (its _ENV) which falls back to the shared globals, so package functions and variables
+ * never collide. Tables defined by the engine (Battle, Engine, ...) are shared.
+ *
+ * Engine functions that act on the package that called them (declare_package_id, define_*, requires_*)
+ * use the package that is currently loading, see LoadingScope.
+ */
 class ScriptResourceManager {
 public:
+  /*! \brief Marks a package as loading while C++ calls into its scripts, restores the previous package when it goes out of scope */
+  class LoadingScope {
+    ScriptResourceManager& manager;
+  public:
+    LoadingScope(ScriptResourceManager& manager, ScriptPackage& package);
+    ~LoadingScope();
+  };
+
+  /*! \brief Held while package scripts run off the frame thread. CollectGarbage() skips those frames, so lua's own collectors are restarted */
+  class LoadingLock {
+    std::unique_lock<std::mutex> lock;
+  public:
+    explicit LoadingLock(ScriptResourceManager& manager);
+  };
+
   ~ScriptResourceManager();
 
-  stx::result_t<sol::state*> LoadScript(const std::string& namespaceId, const std::filesystem::path& path, ScriptPackageType type = ScriptPackageType::other);
+  /**
+  * @brief Packages loaded after this share one lua state per namespace instead of one state each
+  */
+  void SetSharedRuntimes(bool enabled);
+
+  /**
+  * @brief Lua garbage is collected in steps between frames, up to seconds per frame.
+  * 0 leaves collection to lua. Must be set before packages load.
+  */
+  void SetGarbageCollectionBudget(double seconds);
+
+  /**
+  * @brief Steps the garbage collectors of the lua states for the budget or idleSeconds, whichever is smaller
+  *
+  * Once a state finishes a cycle here its own collector is stopped, so scripts do not collect while they run.
+  * It is restarted if memory doubles before the next cycle here finishes, even on frames without a budget.
+  * Does nothing if another thread holds a LoadingLock, lua states cannot be used from two threads.
+  */
+  void CollectGarbage(double idleSeconds);
+
+  stx::result_t<ScriptPackage*> LoadScript(const std::string& namespaceId, const std::filesystem::path& path, ScriptPackageType type = ScriptPackageType::other);
 
-  void DropPackageData(sol::state* state);
+  void DropPackageData(ScriptPackage* package);
   void DropPackageData(const PackageAddress& addr);
   ScriptPackage* DefinePackage(ScriptPackageType type, const std::string& namespaceId, const std::string& fqn, const std::string& path); /* throws */
   ScriptPackage* FetchScriptPackage(const std::string& namespaceId, const std::string& fqn, ScriptPackageType type);
@@ -56,14 +104,56 @@ public:
   static sol::object PrintInvalidAssignMessage(sol::table table, const std::string typeName, const std::string key );
 
 private:
-  std::map<sol::state*, ScriptPackage*> state2package; /*!< lua state pointer to script package */
+  /*! \brief A lua state shared by every package in a namespace */
+  struct SharedRuntime {
+    sol::state* state{ nullptr };
+    std::string namespaceId; //!< bindings keep a reference to this
+    size_t packageCount{};
+  };
+
+  std::map<ScriptPackage*, sol::state*> package2state; /*!< every loaded script package to the lua state it runs in */
   std::map<PackageAddress, ScriptPackage*> address2package; /*!< PackageAddress to script package */
+  std::map<std::string, SharedRuntime> sharedRuntimes; /*!< namespace to shared lua state */
+
+  /*! \brief Progress of the frame driven garbage collection of a lua state */
+  struct Collector {
+    int kbAfterCycle{}; //!< memory in use when the last cycle finished
+    bool collecting{};
+    bool stopped{}; //!< lua's own collector is stopped and only steps between frames collect
+  };
+
+  std::map<lua_State*, Collector> collectors; /*!< every lua state collected between frames */
+  lua_State* lastCollected{ nullptr }; //!< states take turns when the budget runs out
+  std::mutex loadingMutex;
+  double collectionBudget{};
+  std::vector<ScriptPackage*> loadingPackages; /*!< packages currently calling into their scripts, innermost last */
   CardPackagePartitioner* cardPartition{ nullptr };
+  bool useSharedRuntimes{ false };
 
-  void ConfigureEnvironment(ScriptPackage& scriptPackage);
+  /**
+  * @brief Defines every binding in state
+  * @param owner the only package in state, or nullptr when the state is shared
+  */
+  void ConfigureEnvironment(sol::state& state, const std::string& namespaceId, ScriptPackage* owner);
   void DefineSubpackage(ScriptPackage& parentPackage, ScriptPackageType type, const std::string& fqn, const std::string& path); /* throws */
-  void SetSystemFunctions(ScriptPackage& scriptPackage);
-  void SetModPathVariable(sol::state& state, const std::filesystem::path& modDirectory);
+  void SetSystemFunctions(sol::state& state, const std::string& namespaceId, ScriptPackage* owner);
+  void SetModPathVariable(sol::table& environment, const std::filesystem::path& modDirectory);
+  sol::state& AcquireSharedRuntime(const std::string& namespaceId);
+  void ConfigureGarbageCollector(lua_State* L);
+  void ReleasePackageState(ScriptPackage& package);
+
+  /**
+  * @brief The package engine functions act on
+  * @param owner returned when the calling state belongs to a single package
+  * @throws std::runtime_error if no package is loading
+  */
+  ScriptPackage& GetCallingPackage(ScriptPackage* owner);
+
+  /**
+  * @brief Loads a script file without running it, compiled chunks come from LuaBytecodeCache when the source is unchanged
+  * @param environment the loaded chunk's _ENV
+  */
+  static sol::load_result LoadScriptFile(sol::state& state, const std::string& path, const sol::table& environment);
 
   static std::string GetCurrentLine( lua_State* L );
   static stx::result_t<std::string> GetCurrentFile(lua_State* L);
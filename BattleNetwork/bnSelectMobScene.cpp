@@ -401,7 +401,7 @@ void SelectMobScene::onUpdate(double elapsed) {
           { player, programAdvance, std::move(newFolder), mob->GetField(), mob->GetBackground() },
           { mob },
           mob->GetTurnLimit(),
-          sf::Sprite(*mugshot),
+          mugshot,
           mugshotAnim,
           emotions,
           localNaviBlocks
@@ -414,7 +414,7 @@ void SelectMobScene::onUpdate(double elapsed) {
           { player, programAdvance, std::move(newFolder), mob->GetField(), mob->GetBackground() },
           MobBattleProperties::RewardBehavior::take,
           { mob },
-          sf::Sprite(*mugshot),
+          mugshot,
           mugshotAnim,
           emotions,
           localNaviBlocks
@@ -1,20 +1,85 @@
 #include "bnSmartShader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+namespace {
+  // id of the last SmartShader to apply uniforms to each shader object
+  // only touched from draw calls
+  std::unordered_map<const sf::Shader*, uint64_t> lastApplied;
+
+  struct UniformSender {
+    sf::Shader& shader;
+    const std::string& name;
+
+    void operator()(int value) const {
+      shader.setUniform(name, value);
+    }
+
+    void operator()(float value) const {
+      shader.setUniform(name, value);
+    }
+
+    void operator()(const std::vector<float>& value) const {
+      shader.setUniformArray(name, value.data(), value.size());
+    }
+
+    void operator()(const sf::Vector2f& value) const {
+      shader.setUniform(name, value);
+    }
+
+    void operator()(const sf::Color& col) const {
+      shader.setUniform(name,
+        sf::Glsl::Vec4{
+          col.r/255.f,
+          col.g/255.f,
+          col.b/255.f,
+          col.a/255.f
+        }
+      );
+    }
+
+    void operator()(const std::shared_ptr<sf::Texture>& value) const {
+      if (value) {
+        shader.setUniform(name, *value);
+      }
+    }
+
+    template<typename T>
+    void operator()(const T&) const {
+      shader.setUniform(name, sf::Shader::CurrentTexture);
+    }
+  };
+}
+
+  uint64_t SmartShader::NextId() {
+    static std::atomic<uint64_t> next{ 1 };
+    return next++;
+  }
+
   SmartShader::SmartShader() {
     ref = nullptr;
+    id = NextId();
   }
 
   SmartShader::SmartShader(const SmartShader& copy) {
-    funiforms = copy.funiforms;
-    iuniforms = copy.iuniforms;
-    vfuniforms = copy.vfuniforms;
-    duniforms = copy.duniforms;
-    farruniforms = copy.farruniforms;
-    coluniforms = copy.coluniforms;
-    texuniforms = copy.texuniforms;
-    textypeuniforms = copy.textypeuniforms;
-
+    uniforms = copy.uniforms;
     ref = copy.ref;
+    id = NextId();
+  }
+
+  SmartShader& SmartShader::operator=(const SmartShader& rhs) {
+    if (this == &rhs) return *this;
+
+    uniforms = rhs.uniforms;
+    ref = rhs.ref;
+    undoLog.clear();
+    savePoints.clear();
+
+    // our id may still be the last applied to ref but the values are not ours
+    MarkAllDirty();
+    return *this;
   }
 
   SmartShader::~SmartShader() {
@@ -23,15 +88,21 @@
 
   SmartShader::SmartShader(const sf::Shader& rhs) {
     ref = &const_cast<sf::Shader&>(rhs);
+    id = NextId();
   }
 
  SmartShader& SmartShader::operator=(const sf::Shader& rhs) {
-   ref = &const_cast<sf::Shader&>(rhs);
-   return *this;
+   return *this = &rhs;
   }
 
  SmartShader& SmartShader::operator=(const sf::Shader* rhs) {
-   ref = const_cast<sf::Shader*>(rhs);
+   sf::Shader* next = const_cast<sf::Shader*>(rhs);
+
+   if (next != ref) {
+     ref = next;
+     MarkAllDirty();
+   }
+
    return *this;
  }
 
@@ -44,58 +115,58 @@
    return ref != nullptr;
  }
 
-  void SmartShader::ApplyUniforms() {
-    if (!ref) return;
+  SmartShader::Uniform& SmartShader::FindUniform(const std::string& name) {
+    // shaders only have a handful of uniforms, a linear scan beats hashing the name
+    for (Uniform& uniform : uniforms) {
+      if (uniform.name == name) {
+        return uniform;
+      }
+    }
 
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    diter dIter = duniforms.begin();
-    farriter farrIter = farruniforms.begin();
-    vfiter vfIter = vfuniforms.begin();
-    coliter colIter = coluniforms.begin();
-    texiter texIter = texuniforms.begin();
-    textypeiter texTypeIter = textypeuniforms.begin();
+    Uniform& uniform = uniforms.emplace_back();
+    uniform.name = name;
+    uniform.dirty = true;
+    return uniform;
+  }
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, iIter->second);
-    }
+  void SmartShader::Store(const std::string& name, Value&& value) {
+    Uniform& uniform = FindUniform(name);
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, fIter->second);
+    if (!savePoints.empty()) {
+      undoLog.push_back({ static_cast<size_t>(&uniform - uniforms.data()), uniform });
     }
 
-    for (; dIter != duniforms.end(); dIter++) {
-      ref->setUniform(dIter->first, static_cast<float>(dIter->second));
+    if (!(uniform.value == value)) {
+      uniform.value = std::move(value);
+      uniform.dirty = true;
     }
 
-    for (; farrIter != farruniforms.end(); farrIter++) {
-      ref->setUniformArray(farrIter->first, farrIter->second.data(), farrIter->second.size());
-    }
+    uniform.active = true;
+  }
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, vfIter->second);
+  void SmartShader::MarkAllDirty() {
+    for (Uniform& uniform : uniforms) {
+      uniform.dirty = true;
     }
+  }
 
-    for (; colIter != coluniforms.end(); colIter++) {
-      sf::Color col = colIter->second;
-      ref->setUniform(colIter->first, 
-        sf::Glsl::Vec4{ 
-          col.r/255.f,
-          col.g/255.f, 
-          col.b/255.f, 
-          col.a/255.f 
-        }
-      );
-    }
+  void SmartShader::ApplyUniforms() {
+    if (!ref) return;
 
-    for (; texIter != texuniforms.end(); texIter++) {
-      ref->setUniform(texIter->first, *texIter->second);
-    }
+    uint64_t& last = lastApplied[ref];
 
-    for (; texTypeIter != textypeuniforms.end(); texTypeIter++) {
-      ref->setUniform(texTypeIter->first, texTypeIter->second);
+    if (last != id) {
+      // someone else has written to this shader since we last did
+      MarkAllDirty();
+      last = id;
     }
 
+    for (Uniform& uniform : uniforms) {
+      if (!uniform.active || !uniform.dirty) continue;
+
+      std::visit(UniformSender{ *ref, uniform.name }, uniform.value);
+      uniform.dirty = false;
+    }
   }
 
   void SmartShader::ResetUniforms() {
@@ -104,7 +175,7 @@
     }
 
     // NOTE: Leaving this in here in case this comes back to haunt me.
-    //       Basically, revoking shaders was erasing the last shader to update 
+    //       Basically, revoking shaders was erasing the last shader to update
     //       and BattleCharacter shader is shared between all entities in the battle scene
     //       So when someone was dying, the white shader replaced their BattleCharacter shader
     //       but it erased all fields in the last BattleCharacter shader to update which wasn't
@@ -113,97 +184,101 @@
     //       Update order is not the same as Draw order either! I may need to add this code in here again
     //       but will need address the fact the underlining shader in a SmartShader are shared between many resources
     //       and we need to be careful about overwriting their values in a frame!
-    /*iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    diter dIter = duniforms.begin();
-    farriter farrIter = farruniforms.begin();
-    vfiter vfIter = vfuniforms.begin();
-    coliter colIter = coluniforms.begin();
-    texiter texIter = texuniforms.begin();
-    textypeiter texTypeIter = textypeuniforms.begin();
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, 0);
+    // slots are kept so setting the same value next frame does not re-send it
+    for (Uniform& uniform : uniforms) {
+      uniform.active = false;
     }
+  }
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, 0.f);
-    }
+  void SmartShader::SetUniform(const std::string& uniform, float fvalue) {
+    Store(uniform, fvalue);
+  }
 
-    for (; dIter != duniforms.end(); dIter++) {
-      ref->setUniform(dIter->first, 0.f);
-    }
+  void SmartShader::SetUniform(const std::string& uniform, double dvalue)
+  {
+    Store(uniform, static_cast<float>(dvalue));
+  }
 
-    for (; farrIter != farruniforms.end(); farrIter++) {
-      std::vector<float> dummyVec;
-      dummyVec.reserve(farrIter->second.size());
-      ref->setUniformArray(farrIter->first, dummyVec.data(), farrIter->second.size());
-    }
+  void SmartShader::SetUniform(const std::string& uniform, const std::vector<float>& farr)
+  {
+    SetUniform(uniform, farr.data(), farr.size());
+  }
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, 0.f);
-    }
+  void SmartShader::SetUniform(const std::string& uniform, const float* farr, size_t count)
+  {
+    Uniform& slot = FindUniform(uniform);
 
-    for (; colIter != coluniforms.end(); colIter++) {
-      ref->setUniform(colIter->first, 0.f);
+    if (!savePoints.empty()) {
+      undoLog.push_back({ static_cast<size_t>(&slot - uniforms.data()), slot });
     }
 
-    for (; texIter != texuniforms.end(); texIter++) {
-      ref->setUniform(texIter->first, sf::Shader::CurrentTexture);
+    slot.active = true;
+
+    if (auto* arr = std::get_if<std::vector<float>>(&slot.value)) {
+      if (arr->size() == count && std::equal(arr->begin(), arr->end(), farr)) {
+        return;
+      }
+
+      // reuses the slot's storage
+      arr->assign(farr, farr + count);
+    }
+    else {
+      slot.value = std::vector<float>(farr, farr + count);
     }
 
-    for (; texTypeIter != textypeuniforms.end(); texTypeIter++) {
-      ref->setUniform(texTypeIter->first, sf::Shader::CurrentTexture);
-    }*/
+    slot.dirty = true;
+  }
 
-    iuniforms.clear();
-    funiforms.clear();
-    duniforms.clear();
-    farruniforms.clear();
-    vfuniforms.clear();
-    coluniforms.clear();
-    texuniforms.clear();
-    textypeuniforms.clear();
+  void SmartShader::SetUniform(const std::string& uniform, int ivalue) {
+    Store(uniform, ivalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, float fvalue) {
-    funiforms[uniform] = fvalue;
+  void SmartShader::SetUniform(const std::string& uniform, const sf::Vector2f& vfvalue) {
+    Store(uniform, vfvalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, double dvalue)
+  void SmartShader::SetUniform(const std::string& uniform, const sf::Color& colvalue)
   {
-    duniforms[uniform] = dvalue;
+    Store(uniform, colvalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, const std::vector<float>& farr)
+  void SmartShader::SetUniform(const std::string& uniform, const std::shared_ptr<sf::Texture>& texvalue)
   {
-    farruniforms[uniform] = farr;
+    Store(uniform, texvalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, int ivalue) {
-    iuniforms[uniform] = ivalue;
+  void SmartShader::SetUniform(const std::string& uniform, const sf::Shader::CurrentTextureType& value)
+  {
+    Store(uniform, CurrentTexture{});
   }
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Vector2f& vfvalue) {
-    vfuniforms[uniform] = vfvalue;
+  void SmartShader::PushState() {
+    savePoints.push_back(undoLog.size());
   }
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Color& colvalue)
-  {
-    coluniforms[uniform] = colvalue;
-  }
+  void SmartShader::PopState() {
+    if (savePoints.empty()) return;
 
-  void SmartShader::SetUniform(std::string uniform, const std::shared_ptr<sf::Texture>& texvalue)
-  {
-    texuniforms[uniform] = texvalue;
-  }
+    size_t mark = savePoints.back();
+    savePoints.pop_back();
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Shader::CurrentTextureType& value)
-  {
-    textypeuniforms[uniform] = value;
+    // undo in reverse so the oldest saved value for a slot wins
+    while (undoLog.size() > mark) {
+      SavedUniform& saved = undoLog.back();
+      Uniform& uniform = uniforms[saved.index];
+      uniform = std::move(saved.uniform);
+
+      // the changed value may have been sent in between
+      uniform.dirty = true;
+      undoLog.pop_back();
+    }
   }
 
   void SmartShader::Reset() {
     ResetUniforms();
+    uniforms.clear();
+    undoLog.clear();
+    savePoints.clear();
     ref = nullptr;
   }
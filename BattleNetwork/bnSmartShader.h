@@ -1,44 +1,82 @@
 /*! \brief A shader wrapper that intelligently applies itself during draw calls
- * 
- * Currently supports int, float, double, vector2f uniforms
- * 
- * Additional uniforms must be added
+ *
+ * Currently supports int, float, double, float array, vector2f, color and texture uniforms
+ *
+ * Uniforms are kept in a flat list of slots with a dirty flag each.
+ * SFML only exposes uniforms by name, so a slot is only re-sent when its value changed
+ * or when another SmartShader has applied values to the same sf::Shader since our last draw.
+ *
+ * Do not write a uniform directly on a shared sf::Shader that is also set through a SmartShader,
+ * the slot will not know the value on the shader changed.
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
-#include <map>
+#include <string>
+#include <vector>
+#include <variant>
+#include <cstdint>
 
 class SmartShader
 {
   friend class DrawWindow;
 
 private:
+  struct CurrentTexture {
+    bool operator==(const CurrentTexture&) const { return true; }
+  };
+
+  using Value = std::variant<
+    int,
+    float,
+    std::vector<float>,
+    sf::Vector2f,
+    sf::Color,
+    std::shared_ptr<sf::Texture>,
+    CurrentTexture
+  >;
+
+  struct Uniform {
+    std::string name;
+    Value value;
+    bool active{}; //!< false after ResetUniforms(), the slot is kept to compare against the last sent value
+    bool dirty{}; //!< value differs from what was last sent to ref
+  };
+
+  struct SavedUniform {
+    size_t index{};
+    Uniform uniform;
+  };
+
   sf::Shader* ref; /*!< Pointer to shader object */
-  std::map<std::string, int>    iuniforms; /*!< lookup of integer uniforms */
-  std::map<std::string, float>  funiforms; /*!< lookup of float uniforms */
-  std::map<std::string, double> duniforms; /*!< lookup of double uniforms */
-  std::map<std::string, std::vector<float>> farruniforms; /*! lookup of float arrays */
-  std::map<std::string, sf::Vector2f> vfuniforms; /*!< lookup of vector2f uniforms */
-  std::map<std::string, sf::Color> coluniforms; /*!< lookup of sf::Color uniforms */
-  std::map<std::string, std::shared_ptr<sf::Texture>> texuniforms; /*! lookups of texture uniforms */
-  std::map<std::string, sf::Shader::CurrentTextureType> textypeuniforms;
-
-  typedef std::map<std::string, int>::iterator iiter; 
-  typedef std::map<std::string, float>::iterator fiter;
-  typedef std::map<std::string, double>::iterator diter;
-  typedef std::map<std::string, std::vector<float>>::iterator farriter;
-  typedef std::map<std::string, sf::Vector2f>::iterator vfiter;
-  typedef std::map<std::string, sf::Color>::iterator coliter;
-  typedef std::map<std::string, std::shared_ptr<sf::Texture>>::iterator texiter;
-  typedef std::map<std::string, sf::Shader::CurrentTextureType>::iterator textypeiter;
-
-  /**
-   * @brief Applies all registered uniform values before drawing
+  uint64_t id; /*!< Unique id used to tell if we were the last to apply uniforms to ref */
+  std::vector<Uniform> uniforms; /*!< Uniform slots in the order they were first set */
+  std::vector<SavedUniform> undoLog; /*!< Slot values before they were changed since the last PushState() */
+  std::vector<size_t> savePoints; /*!< undoLog size for every PushState() */
+
+  static uint64_t NextId();
+
+  /**
+   * @brief Finds the slot for a uniform, creating an inactive one if it does not exist
+   */
+  Uniform& FindUniform(const std::string& name);
+
+  /**
+   * @brief Stores a value in a slot and marks it dirty if it changed
+   */
+  void Store(const std::string& name, Value&& value);
+
+  /**
+   * @brief Marks every slot dirty so the next apply sends everything
+   */
+  void MarkAllDirty();
+
+  /**
+   * @brief Applies all changed uniform values before drawing
    */
   void ApplyUniforms();
-  
+
   /**
    * @brief Clears the shader object of all uniform values
    */
@@ -49,96 +87,121 @@ public:
    * @brief Constructs a smart shader with pointer to sf::Shader ref set to nullptr
    */
   SmartShader();
-  
+
   /**
    * @brief Constructs a smart shader from another smart shader
    */
   SmartShader(const SmartShader&);
-  
+
+  /**
+   * @brief Copies the uniform values and shader object of another smart shader
+   */
+  SmartShader& operator=(const SmartShader&);
+
   /**
    * @brief Frees the reference to the shader object and empties the uniform dictionaries
    */
   ~SmartShader();
-  
+
   /**
    * @brief Assigns shader object ref to rhs
    * @param rhs shader object to assign itself to
    */
   SmartShader(const sf::Shader& rhs);
-  
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader& rhs);
-  
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader* rhs);
-  
+
   /**
    * @brief Set a float uniform value
    * @param uniform the name of the uniform
    * @param fvalue
    */
-  void SetUniform(std::string uniform, float fvalue);
+  void SetUniform(const std::string& uniform, float fvalue);
 
   /**
    * @brief Set a double uniform value
    * @param uniform the name of the uniform
-   * @param dvalue
+   * @param dvalue sent as a float
    */
-  void SetUniform(std::string uniform, double dvalue);
+  void SetUniform(const std::string& uniform, double dvalue);
 
   /**
    * @brief Set a float array uniform value
    * @param uniform the name of the uniform
    * @param farrvalue
    */
-  void SetUniform(std::string uniform, const std::vector<float>& farr);
-  
+  void SetUniform(const std::string& uniform, const std::vector<float>& farr);
+
+  /**
+   * @brief Set a float array uniform value without building a vector
+   * @param uniform the name of the uniform
+   * @param farr first element of the array
+   * @param count number of elements
+   */
+  void SetUniform(const std::string& uniform, const float* farr, size_t count);
+
   /**
    * @brief Set an integer uniform value
    * @param uniform the name of the uniform
    * @param ivalue
    */
-  void SetUniform(std::string uniform, int ivalue);
-  
+  void SetUniform(const std::string& uniform, int ivalue);
+
   /**
    * @brief Set a vector2f uniform value
    * @param uniform the name of the uniform
    * @param vfvalue
    */
-  void SetUniform(std::string uniform, const sf::Vector2f& vfvalue);
-  
+  void SetUniform(const std::string& uniform, const sf::Vector2f& vfvalue);
+
   /**
    * @brief Set a color uniform value
    * @param uniform the name of the uniform
    * @param colvalue
    */
-  void SetUniform(std::string uniform, const sf::Color& colvalue);
+  void SetUniform(const std::string& uniform, const sf::Color& colvalue);
 
   /**
    * @brief Set a texture uniform value
    * @param uniform the name of the uniform
    * @param texvalue
    */
-  void SetUniform(std::string uniform, const std::shared_ptr<sf::Texture>& texvalue);
+  void SetUniform(const std::string& uniform, const std::shared_ptr<sf::Texture>& texvalue);
 
   /**
   * @brief Set a texture type uniform value
   * @param uniform the name of the uniform
   * @param value
   */
-  void SetUniform(std::string uniform, const sf::Shader::CurrentTextureType& value);
+  void SetUniform(const std::string& uniform, const sf::Shader::CurrentTextureType& value);
+
+  /**
+   * @brief Remembers the current uniform values so they can be restored with PopState()
+   *
+   * Cheaper than copying the whole SmartShader, only slots changed afterwards are saved
+   */
+  void PushState();
+
+  /**
+   * @brief Restores the uniform values from the matching PushState()
+   */
+  void PopState();
 
   /**
    * @brief Sets all pre-existing uniforms to 0, empties the lookups, and frees ref
    */
   void Reset();
-  
+
   /**
    * @brief Fetch the shader object
    * @return sf::Shader*
@@ -151,4 +214,3 @@ public:
    */
   bool HasShader();
 };
-
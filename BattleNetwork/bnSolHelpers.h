@@ -1,9 +1,10 @@
 #pragma once
 #include <sol/sol.hpp>
 #include "stx/result.h"
+#include "bnLuaProfiler.h"
 
 template<typename Table, typename ...Args>
-stx::result_t<sol::object> CallLuaFunction(Table& script, const std::string& functionName, Args... args)
+stx::result_t<sol::object> CallLuaFunction(Table& script, const std::string& functionName, Args&&... args)
 {
   sol::object possible_func = script[functionName];
 
@@ -13,6 +14,7 @@ stx::result_t<sol::object> CallLuaFunction(Table& script, const std::string& fun
   }
 
   sol::protected_function func = possible_func;
+  LuaProfiler::CallScope profile(func.lua_state());
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -26,7 +28,7 @@ stx::result_t<sol::object> CallLuaFunction(Table& script, const std::string& fun
 }
 
 template<typename Result, typename Table, typename ...Args>
-stx::result_t<Result> CallLuaFunctionExpectingValue(Table& script, const std::string& functionName, Args... args)
+stx::result_t<Result> CallLuaFunctionExpectingValue(Table& script, const std::string& functionName, Args&&... args)
 {
   auto result = CallLuaFunction(script, functionName, std::forward<Args>(args)...);
 
@@ -46,7 +48,8 @@ stx::result_t<Result> CallLuaFunctionExpectingValue(Table& script, const std::st
 }
 
 template<typename ...Args>
-stx::result_t<sol::object> CallLuaCallback(const sol::protected_function& func, Args... args) {
+stx::result_t<sol::object> CallLuaCallback(const sol::protected_function& func, Args&&... args) {
+  LuaProfiler::CallScope profile(func.lua_state());
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -60,8 +63,9 @@ stx::result_t<sol::object> CallLuaCallback(const sol::protected_function& func,
 }
 
 template<typename Result, typename ...Args>
-stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::protected_function& func, Args... args)
+stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::protected_function& func, Args&&... args)
 {
+  LuaProfiler::CallScope profile(func.lua_state());
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -81,8 +85,9 @@ stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::protected_functio
 }
 
 template<typename ...Args>
-stx::result_t<bool> CallLuaCallbackExpectingBool(const sol::protected_function& func, Args... args)
+stx::result_t<bool> CallLuaCallbackExpectingBool(const sol::protected_function& func, Args&&... args)
 {
+  LuaProfiler::CallScope profile(func.lua_state());
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -100,7 +105,7 @@ stx::result_t<bool> CallLuaCallbackExpectingBool(const sol::protected_function&
 }
 
 template<typename ...Args>
-stx::result_t<sol::object> CallLuaCallback(const sol::object& object, Args... args) {
+stx::result_t<sol::object> CallLuaCallback(const sol::object& object, Args&&... args) {
   if (!object.valid() || object.get_type() != sol::type::function) {
     return stx::error<sol::object>("Expected function");
   }
@@ -110,7 +115,7 @@ stx::result_t<sol::object> CallLuaCallback(const sol::object& object, Args... ar
 }
 
 template<typename Result, typename ...Args>
-stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::object& object, Args... args) {
+stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::object& object, Args&&... args) {
   if (object.get_type() != sol::type::function) {
     return stx::error<Result>("Expected function");
   }
@@ -120,7 +125,7 @@ stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::object& object, A
 }
 
 template<typename ...Args>
-stx::result_t<bool> CallLuaCallbackExpectingBool(const sol::object& object, Args... args) {
+stx::result_t<bool> CallLuaCallbackExpectingBool(const sol::object& object, Args&&... args) {
   if (object.get_type() != sol::type::function) {
     return stx::error<bool>("Expected function");
   }
@@ -145,8 +150,10 @@ inline void ExpectLuaFunction(sol::object object) {
   }
 }
 
-inline stx::result_t<sol::object> EvalLua(sol::state& lua, const std::string& dataString) {
-  sol::protected_function_result result = lua.safe_script(dataString, sol::script_pass_on_error);
+inline stx::result_t<sol::object> EvalLua(sol::table& environment, const std::string& dataString) {
+  sol::state_view lua(environment.lua_state());
+  sol::environment env(environment);
+  sol::protected_function_result result = lua.safe_script(dataString, env, sol::script_pass_on_error);
 
   if (!result.valid()) {
     sol::error error = result;
@@ -20,6 +20,7 @@ SpriteProxyNode::SpriteProxyNode(SpriteProxyNode&& rhs) noexcept
 {
   std::swap(allocatedSprite, rhs.allocatedSprite);
   std::swap(childNodes, rhs.childNodes);
+  std::swap(childNodesSorted, rhs.childNodesSorted);
   std::swap(layer, rhs.layer);
   std::swap(parent, rhs.parent);
   std::swap(shader, rhs.shader);
@@ -147,24 +148,22 @@ void SpriteProxyNode::draw(sf::RenderTarget& target, sf::RenderStates states) co
     states.shader = nullptr;
   }
 
-  std::vector<SceneNode*> copies;
-  copies.reserve(childNodes.size() + 1);
+  SortChildNodes();
 
-  for (auto& child : childNodes) {
-    copies.push_back(child.get());
-  }
-
-  copies.push_back((SceneNode*)this);
-
-  std::sort(copies.begin(), copies.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+  // children on our layer or above are drawn behind us
+  bool drawnSelf = false;
 
-  // draw its children
-  for (std::size_t i = 0; i < copies.size(); i++) {
+  for (auto& child : childNodes) {
     // If it's time to draw our scene node, we draw the proxy sprite
-    if(copies[i] == this) {
+    if (!drawnSelf && child->GetLayer() < GetLayer()) {
       target.draw(*sprite, states);
-    } else {
-      copies[i]->draw(target, states);
+      drawnSelf = true;
     }
+
+    child->draw(target, states);
+  }
+
+  if (!drawnSelf) {
+    target.draw(*sprite, states);
   }
 }
@@ -9,7 +9,7 @@ std::shared_ptr<SyncNode> SyncNodeContainer::AddSyncNode(SceneNode& sceneNode, A
   syncNode->sprite = std::make_shared<SpriteProxyNode>();
   syncNode->syncItem.anim = &syncNode->animation;
   syncNode->syncItem.node = syncNode->sprite;
-  syncNode->syncItem.point = point;
+  syncNode->syncItem.point = PointNames::Intern(point);
 
   syncNodes.push_back(syncNode);
   sceneNode.AddNode(syncNode->sprite);
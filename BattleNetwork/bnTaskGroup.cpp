@@ -1,32 +1,40 @@
 #include <string>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <thread>
 #include "bnTaskGroup.h"
+#include "bnLogger.h"
 
 TaskGroup::TaskGroup(TaskGroup && other) noexcept
 {
   std::swap(tasks, other.tasks);
-  std::swap(currentTask, other.currentTask);
+  currentTask = other.currentTask.exchange(0);
   std::swap(maxTasks, other.maxTasks);
+  std::swap(workerCount, other.workerCount);
   other.tasks.clear();
-  other.currentTask = 0;
+  other.maxTasks = 0;
 }
 
 const bool TaskGroup::HasMore() const
 {
-  return tasks.size();
+  return currentTask < maxTasks;
 }
 
 void TaskGroup::DoNextTask()
 {
-  if (tasks.size()) {
-    tasks.begin()->second();
-    tasks.erase(tasks.begin());
+  // dependencies are always added first so this order satisfies them
+  if (HasMore()) {
+    tasks[currentTask].callback();
     currentTask++;
   }
 }
 
 const std::string & TaskGroup::GetTaskName() const
 {
-  return tasks.begin()->first;
+  return tasks[currentTask].name;
 }
 
 const unsigned TaskGroup::GetTaskNumber() const
@@ -39,8 +47,148 @@ const unsigned TaskGroup::GetTotalTasks() const
   return maxTasks;
 }
 
-void TaskGroup::AddTask(const std::string & name, Callback<void()>&& task)
+void TaskGroup::AddTask(const std::string & name, Callback<void()>&& task, const std::vector<std::string>& dependencies)
 {
-  tasks.insert(tasks.end(), std::make_pair(name, std::move(task)));
+  size_t index = tasks.size();
+
+  Task& added = tasks.emplace_back();
+  added.name = name;
+  added.callback = std::move(task);
+
+  for (const std::string& dependency : dependencies) {
+    auto iter = std::find_if(tasks.begin(), tasks.begin() + index, [&dependency](const Task& other) {
+      return other.name == dependency;
+    });
+
+    if (iter == tasks.begin() + index) {
+      Logger::Logf(LogLevel::warning, "Task `%s` depends on `%s` which was not added before it", name.c_str(), dependency.c_str());
+      continue;
+    }
+
+    iter->dependents.push_back(index);
+    tasks[index].dependencies++;
+  }
+
   maxTasks++;
 }
+
+void TaskGroup::SetWorkerCount(unsigned count)
+{
+  workerCount = count;
+}
+
+void TaskGroup::Run(const TaskEvent& onBegin, const TaskEvent& onComplete)
+{
+  unsigned workers = workerCount;
+
+  if (workers == 0) {
+    workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workers = std::min(workers, maxTasks - currentTask);
+
+  if (workers <= 1) {
+    while (HasMore()) {
+      const std::string taskname = GetTaskName();
+
+      if (onBegin) onBegin(taskname, currentTask);
+      DoNextTask();
+      if (onComplete) onComplete(taskname, currentTask);
+    }
+
+    return;
+  }
+
+  std::mutex mutex;
+  std::condition_variable taskReady;
+  std::queue<size_t> ready;
+  std::vector<unsigned> waitingOn(tasks.size());
+  std::exception_ptr error;
+  unsigned running{};
+
+  // tasks before currentTask already ran with DoNextTask()
+  for (size_t i = 0; i < tasks.size(); i++) {
+    waitingOn[i] = tasks[i].dependencies;
+  }
+
+  for (size_t i = 0; i < currentTask; i++) {
+    for (size_t dependent : tasks[i].dependents) {
+      waitingOn[dependent]--;
+    }
+  }
+
+  for (size_t i = currentTask; i < tasks.size(); i++) {
+    if (waitingOn[i] == 0) {
+      ready.push(i);
+    }
+  }
+
+  auto work = [&] {
+    std::unique_lock lock(mutex);
+
+    while (true) {
+      taskReady.wait(lock, [&] {
+        return !ready.empty() || error || running == 0;
+      });
+
+      if (error || ready.empty()) {
+        // failed, or nothing is running that could make more tasks ready
+        break;
+      }
+
+      size_t index = ready.front();
+      ready.pop();
+      running++;
+
+      Task& task = tasks[index];
+      unsigned finished = currentTask;
+      lock.unlock();
+
+      try {
+        if (onBegin) onBegin(task.name, finished);
+        task.callback();
+        finished = ++currentTask;
+        if (onComplete) onComplete(task.name, finished);
+      }
+      catch (...) {
+        lock.lock();
+        running--;
+
+        if (!error) {
+          error = std::current_exception();
+        }
+
+        taskReady.notify_all();
+        break;
+      }
+
+      lock.lock();
+      running--;
+
+      for (size_t dependent : task.dependents) {
+        if (--waitingOn[dependent] == 0) {
+          ready.push(dependent);
+        }
+      }
+
+      taskReady.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+
+  for (unsigned i = 1; i < workers; i++) {
+    threads.emplace_back(work);
+  }
+
+  work();
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
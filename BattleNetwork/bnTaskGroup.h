@@ -1,10 +1,35 @@
 #pragma once
-#include <list>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
 #include "bnCallback.h"
 
+/*! \brief A list of named tasks, used to load the game in the background
+ *
+ * Tasks can depend on tasks added before them. DoNextTask() runs the tasks one at a time
+ * in the order they were added. Run() starts every task whose dependencies have finished
+ * on a pool of worker threads, so independent tasks load at the same time.
+ */
 class TaskGroup {
-  std::list<std::pair<std::string, Callback<void()>>> tasks;
-  unsigned currentTask{}, maxTasks{};
+public:
+  /**
+  * @param taskName the task beginning or completing
+  * @param finished the number of tasks that have completed so far
+  */
+  using TaskEvent = std::function<void(const std::string& taskName, unsigned finished)>;
+
+private:
+  struct Task {
+    std::string name;
+    Callback<void()> callback;
+    std::vector<size_t> dependents; //!< tasks waiting on this one
+    unsigned dependencies{}; //!< number of tasks this one waits on
+  };
+
+  std::vector<Task> tasks;
+  std::atomic<unsigned> currentTask{};
+  unsigned maxTasks{}, workerCount{ 1 };
 public:
   TaskGroup() = default;
   TaskGroup(TaskGroup&& other) noexcept;
@@ -15,5 +40,24 @@ public:
   const std::string& GetTaskName() const;
   const unsigned GetTaskNumber() const;
   const unsigned GetTotalTasks() const;
-  void AddTask(const std::string& name, Callback<void()>&& task);
+
+  /**
+  * @brief Adds a task that runs after every task named in dependencies has finished
+  * @param dependencies names of tasks that were already added
+  */
+  void AddTask(const std::string& name, Callback<void()>&& task, const std::vector<std::string>& dependencies = {});
+
+  /**
+  * @brief Sets how many threads Run() uses
+  * @param count 0 uses one per hardware thread, 1 runs every task on the calling thread
+  */
+  void SetWorkerCount(unsigned count);
+
+  /**
+  * @brief Runs every remaining task and returns once they have all finished
+  *
+  * The calling thread is one of the workers. Events are called from whichever worker runs the task.
+  * If a task throws, no more tasks are started and the exception is rethrown here once running tasks finish.
+  */
+  void Run(const TaskEvent& onBegin = nullptr, const TaskEvent& onComplete = nullptr);
 };
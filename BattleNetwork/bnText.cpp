@@ -2,17 +2,10 @@
 #include <cmath>
 #include <cctype> // for control codes
 
-void Text::AddLetterQuad(sf::Vector2f position, const sf::Color & color, char letter) const
-{
-  font.SetLetter(letter);
-  const auto texcoords = font.GetTextureCoords();
-  const auto origin = font.GetOrigin();
-  const sf::Texture& texture = font.GetTexture();
-  float width  = static_cast<float>(texture.getSize().x);
-  float height = static_cast<float>(texture.getSize().y);
-  
-  float left   = 0;
-  float top    = 0;
+void Text::AddLetterQuad(std::size_t index, sf::Vector2f position, const sf::Color & color, const Font::Glyph& glyph) const
+{
+  const sf::IntRect& texcoords = glyph.texcoords;
+
   float right  = static_cast<float>(texcoords.width);
   float bottom = static_cast<float>(texcoords.height);
 
@@ -27,24 +20,31 @@ void Text::AddLetterQuad(sf::Vector2f position, const sf::Color & color, char le
   float u2 = static_cast<float>(texcoords.left + texcoords.width);
   float v2 = static_cast<float>(texcoords.top + texcoords.height);
 
-  position -= origin;
+  position -= glyph.origin;
 
-  vertices.append(sf::Vertex(sf::Vector2f(position.x, position.y + bottom), color, sf::Vector2f(u1, v2)));
-  vertices.append(sf::Vertex(sf::Vector2f(position.x, position.y), color, sf::Vector2f(u1, v1)));
-  vertices.append(sf::Vertex(sf::Vector2f(position.x + right, position.y + bottom), color, sf::Vector2f(u2, v2)));
-  vertices.append(sf::Vertex(sf::Vector2f(position.x, position.y), color, sf::Vector2f(u1, v1)));
-  vertices.append(sf::Vertex(sf::Vector2f(position.x + right, position.y + bottom), color, sf::Vector2f(u2, v2)));
-  vertices.append(sf::Vertex(sf::Vector2f(position.x + right, position.y), color, sf::Vector2f(u2, v1)));
+  vertices[index + 0] = sf::Vertex(sf::Vector2f(position.x, position.y + bottom), color, sf::Vector2f(u1, v2));
+  vertices[index + 1] = sf::Vertex(sf::Vector2f(position.x, position.y), color, sf::Vector2f(u1, v1));
+  vertices[index + 2] = sf::Vertex(sf::Vector2f(position.x + right, position.y + bottom), color, sf::Vector2f(u2, v2));
+  vertices[index + 3] = sf::Vertex(sf::Vector2f(position.x, position.y), color, sf::Vector2f(u1, v1));
+  vertices[index + 4] = sf::Vertex(sf::Vector2f(position.x + right, position.y + bottom), color, sf::Vector2f(u2, v2));
+  vertices[index + 5] = sf::Vertex(sf::Vector2f(position.x + right, position.y), color, sf::Vector2f(u2, v1));
 }
 
 void Text::UpdateGeometry() const
 {
   if (!geometryDirty) return;
 
-  vertices.clear();
   bounds = sf::FloatRect();
 
-  if (message.empty()) return; // nothing to draw
+  if (message.empty()) {
+    vertices.clear();
+    return; // nothing to draw
+  }
+
+  // Size for the worst case of every char being a glyph, trimmed after
+  // VertexArray keeps its capacity so changing labels stop allocating
+  vertices.resize(message.size() * 6u);
+  std::size_t vertexCount = 0;
 
   // Precompute the variables needed by the algorithm
   float whitespaceWidth = font.GetWhiteSpaceWidth();
@@ -68,14 +68,18 @@ void Text::UpdateGeometry() const
       // skip user-defined control codes
       if (letter > 0 && iscntrl(letter)) continue;
 
-      AddLetterQuad(sf::Vector2f(x, y), color, letter);
+      const Font::Glyph& glyph = font.GetGlyph(letter);
+      AddLetterQuad(vertexCount, sf::Vector2f(x, y), color, glyph);
+      vertexCount += 6u;
 
-      x += font.GetLetterWidth() + letterSpacing;
+      x += static_cast<float>(glyph.texcoords.width) + letterSpacing;
     }
 
     width = std::max(x, width);
   }
 
+  vertices.resize(vertexCount);
+
   // Update the bounding rectangle
   bounds.left = 0;
   bounds.top = 0;
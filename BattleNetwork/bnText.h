@@ -13,8 +13,8 @@ private:
   mutable sf::VertexArray vertices;
   mutable bool geometryDirty; //!< Flag if text needs to be recomputed due to a change in properties
 
-  // Add a glyph quad to the vertex array
-  void AddLetterQuad(sf::Vector2f position, const sf::Color& color, char letter) const;
+  // Write a glyph quad into the vertex array starting at index
+  void AddLetterQuad(std::size_t index, sf::Vector2f position, const sf::Color& color, const Font::Glyph& glyph) const;
 
   // Computes geometry before draw
   void UpdateGeometry() const;
@@ -0,0 +1,193 @@
+#include "bnTextureAtlas.h"
+#include "bnLogger.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+TextureAtlas::TextureAtlas(unsigned pageSize, unsigned maxImageSize) :
+  pageSize(pageSize),
+  maxImageSize(std::min(maxImageSize, pageSize))
+{
+}
+
+bool TextureAtlas::Add(const std::string& path, const sf::Image& image, const std::shared_ptr<sf::Texture>& texture) {
+  std::scoped_lock lock(mutex);
+
+  auto iter = regionsFromPath.find(path);
+  std::optional<Region> region;
+
+  if (iter != regionsFromPath.end()) {
+    // reloaded after the cache expired, the pixels are already packed
+    region = iter->second;
+  }
+  else {
+    region = Pack(image);
+
+    if (!region) {
+      return false;
+    }
+
+    regionsFromPath.emplace(path, *region);
+  }
+
+  if (texture) {
+    regionsFromTexture[texture.get()] = LinkedTexture{ texture, *region };
+  }
+
+  return true;
+}
+
+std::optional<TextureAtlas::Region> TextureAtlas::Find(const sf::Texture* texture) const {
+  std::scoped_lock lock(mutex);
+
+  auto iter = regionsFromTexture.find(texture);
+
+  if (iter == regionsFromTexture.end() || iter->second.texture.expired()) {
+    return {};
+  }
+
+  return iter->second.region;
+}
+
+std::optional<TextureAtlas::Region> TextureAtlas::Find(const std::string& path) const {
+  std::scoped_lock lock(mutex);
+
+  auto iter = regionsFromPath.find(path);
+
+  if (iter == regionsFromPath.end()) {
+    return {};
+  }
+
+  return iter->second;
+}
+
+size_t TextureAtlas::GetPageCount() const {
+  std::scoped_lock lock(mutex);
+  return pages.size();
+}
+
+size_t TextureAtlas::ReleaseUnusedPages() {
+  std::scoped_lock lock(mutex);
+
+  std::unordered_set<const sf::Texture*> usedPages;
+
+  for (auto iter = regionsFromTexture.begin(); iter != regionsFromTexture.end();) {
+    if (iter->second.texture.expired()) {
+      iter = regionsFromTexture.erase(iter);
+      continue;
+    }
+
+    usedPages.insert(iter->second.region.page);
+    iter++;
+  }
+
+  size_t released = 0;
+
+  for (auto page = pages.begin(); page != pages.end();) {
+    const sf::Texture* pageTexture = &(*page)->texture;
+
+    if (usedPages.count(pageTexture)) {
+      page++;
+      continue;
+    }
+
+    for (auto iter = regionsFromPath.begin(); iter != regionsFromPath.end();) {
+      if (iter->second.page == pageTexture) {
+        iter = regionsFromPath.erase(iter);
+        continue;
+      }
+
+      iter++;
+    }
+
+    page = pages.erase(page);
+    released++;
+  }
+
+  if (released) {
+    Logger::Logf(LogLevel::debug, "Released %i unused texture atlas pages", static_cast<int>(released));
+  }
+
+  return released;
+}
+
+std::optional<TextureAtlas::Region> TextureAtlas::Pack(const sf::Image& image) {
+  sf::Vector2u size = image.getSize();
+
+  if (size.x == 0 || size.y == 0 || size.x > maxImageSize || size.y > maxImageSize) {
+    return {};
+  }
+
+  sf::IntRect rect;
+  Page* target = nullptr;
+
+  for (std::unique_ptr<Page>& page : pages) {
+    if (PlaceOnPage(*page, size.x, size.y, rect)) {
+      target = page.get();
+      break;
+    }
+  }
+
+  if (!target) {
+    if (pages.empty()) {
+      // needs a GL context, so it waits until the first page is made
+      pageSize = std::min(pageSize, sf::Texture::getMaximumSize());
+
+      if (size.x > pageSize || size.y > pageSize) {
+        return {};
+      }
+    }
+
+    auto page = std::make_unique<Page>();
+
+    if (!page->texture.create(pageSize, pageSize)) {
+      Logger::Logf(LogLevel::critical, "Failed to create %ux%u texture atlas page", pageSize, pageSize);
+      return {};
+    }
+
+    // pages start with garbage, clear them so padding is transparent
+    sf::Image blank;
+    blank.create(pageSize, pageSize, sf::Color::Transparent);
+    page->texture.update(blank);
+
+    if (!PlaceOnPage(*page, size.x, size.y, rect)) {
+      return {};
+    }
+
+    target = page.get();
+    pages.push_back(std::move(page));
+
+    Logger::Logf(LogLevel::debug, "Texture atlas page %i created", static_cast<int>(pages.size()));
+  }
+
+  target->texture.update(image, rect.left, rect.top);
+
+  return Region{ &target->texture, rect };
+}
+
+bool TextureAtlas::PlaceOnPage(Page& page, unsigned width, unsigned height, sf::IntRect& rect) {
+  unsigned paddedWidth = width + PADDING;
+  unsigned paddedHeight = height + PADDING;
+
+  unsigned x = page.cursorX;
+  unsigned y = page.shelfY;
+  unsigned shelfHeight = page.shelfHeight;
+
+  if (x + width > pageSize) {
+    // start a new shelf under the current one
+    y += shelfHeight;
+    shelfHeight = 0;
+    x = 0;
+  }
+
+  if (y + height > pageSize) {
+    return false;
+  }
+
+  rect = sf::IntRect(x, y, width, height);
+  page.cursorX = x + paddedWidth;
+  page.shelfY = y;
+  page.shelfHeight = std::max(shelfHeight, paddedHeight);
+
+  return true;
+}
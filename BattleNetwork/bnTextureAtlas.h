@@ -0,0 +1,88 @@
+/*! \file bnTextureAtlas.h */
+
+/*! \brief Packs small images into shared texture pages
+ *
+ * Images are placed on shelves left to right, a new shelf is started below
+ * when a row is full and a new page is made when a page is full.
+ * Regions are never moved, adding the same path again returns its existing region.
+ * Space is reclaimed a page at a time, once no texture linked to the page is alive.
+ *
+ * Textures loaded on their own can be linked to their region so draw code that batches
+ * (see RenderQueue) can swap in the page and offset texture coordinates.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextureAtlas {
+public:
+  struct Region {
+    const sf::Texture* page{ nullptr };
+    sf::IntRect rect;
+  };
+
+  /**
+  * @param pageSize width and height of every page, clamped to the largest texture the GPU supports
+  * @param maxImageSize images wider or taller than this are not packed
+  */
+  TextureAtlas(unsigned pageSize = 2048, unsigned maxImageSize = 1024);
+
+  TextureAtlas(const TextureAtlas&) = delete;
+
+  /**
+  * @brief Packs the image loaded from path and links texture to its region
+  * @param texture the texture loaded on its own from the same image
+  * @return false if the image is too large to pack
+  */
+  bool Add(const std::string& path, const sf::Image& image, const std::shared_ptr<sf::Texture>& texture);
+
+  /**
+  * @brief Region of a texture previously passed to Add()
+  */
+  std::optional<Region> Find(const sf::Texture* texture) const;
+
+  /**
+  * @brief Region of the image loaded from path
+  */
+  std::optional<Region> Find(const std::string& path) const;
+
+  size_t GetPageCount() const;
+
+  /**
+  * @brief Frees pages whose linked textures have all been freed, along with their regions
+  * @return number of pages freed
+  */
+  size_t ReleaseUnusedPages();
+
+private:
+  struct Page {
+    sf::Texture texture;
+    unsigned shelfY{}; //!< top of the current shelf
+    unsigned shelfHeight{}; //!< tallest image on the current shelf
+    unsigned cursorX{}; //!< next free column on the current shelf
+  };
+
+  struct LinkedTexture {
+    std::weak_ptr<sf::Texture> texture; //!< a new texture can reuse the address after this one expires
+    Region region;
+  };
+
+  std::optional<Region> Pack(const sf::Image& image);
+  bool PlaceOnPage(Page& page, unsigned width, unsigned height, sf::IntRect& rect);
+
+  static constexpr unsigned PADDING = 1; //!< empty pixels between images so neighbors never bleed
+
+  mutable std::mutex mutex;
+  unsigned pageSize{};
+  unsigned maxImageSize{};
+  std::vector<std::unique_ptr<Page>> pages;
+  std::unordered_map<std::string, Region> regionsFromPath;
+  std::unordered_map<const sf::Texture*, LinkedTexture> regionsFromTexture;
+};
@@ -5,6 +5,9 @@
 #include <sstream>
 #include <fstream>
 #include <mutex>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
 
 using std::ifstream;
 using std::stringstream;
@@ -18,33 +21,22 @@ void TextureResourceManager::LoadAllTextures(std::atomic<int>& status)
 
 void TextureResourceManager::HandleExpiredTextureCache()
 {
-  // std::scoped_lock lock(mutex);
-
-  auto iter = texturesFromPath.begin();
-  while (iter != texturesFromPath.end()) {
-    if (iter->second.GetSecondsSinceLastRequest() > 60.0f) {
-      if (iter->second.IsInUse()) {
-        iter++; continue;
-      }
-
-      // 1 minute is long enough
-      Logger::Logf(LogLevel::debug, "Texture data %s expired", iter->first.c_str());
-      iter = texturesFromPath.erase(iter);
-      continue;
-    }
+  texturesFromPath.HandleExpired();
 
-    iter++;
+  if (atlas) {
+    atlas->ReleaseUnusedPages();
   }
 }
 
-std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
-  //std::scoped_lock lock(mutex);
-
-  auto iter = texturesFromPath.find(_path);
+void TextureResourceManager::SetMemoryBudget(size_t bytes)
+{
+  texturesFromPath.SetBudget(bytes);
+}
 
+std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
   // check cache first
-  if (iter != texturesFromPath.end()) {
-    return iter->second.GetResource();
+  if (std::shared_ptr<Texture> cached = texturesFromPath.Find(_path)) {
+    return cached;
   }
 
   auto pathsIter = std::find(paths.begin(), paths.end(), _path);
@@ -56,7 +48,7 @@ std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
   }
 
   std::shared_ptr<Texture> texture = std::make_shared<Texture>();
-  
+
   if (!texture->loadFromFile(_path)) {
     Logger::Logf(LogLevel::critical, "Failed loading texture: %s", _path.c_str());
   } else {
@@ -64,14 +56,196 @@ std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
   }
 
   if (!skipCaching) {
-    texturesFromPath.insert(std::make_pair(_path, texture));
+    sf::Vector2u size = texture->getSize();
+    texture = texturesFromPath.Insert(_path, texture, static_cast<size_t>(size.x) * size.y * 4u);
+  }
+
+  return texture;
+}
+
+namespace {
+  // reads the size out of the IHDR chunk which always comes first in a PNG
+  bool ReadPNGSize(const std::string& path, sf::Vector2u& size) {
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    ifstream file(path, std::ios::binary);
+    unsigned char header[24]{};
+
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+      return false;
+    }
+
+    if (!std::equal(std::begin(signature), std::end(signature), header) || std::string_view(reinterpret_cast<char*>(header + 12), 4) != "IHDR") {
+      return false;
+    }
+
+    auto readBE = [](const unsigned char* bytes) {
+      return (unsigned(bytes[0]) << 24) | (unsigned(bytes[1]) << 16) | (unsigned(bytes[2]) << 8) | unsigned(bytes[3]);
+    };
+
+    size = { readBE(header + 16), readBE(header + 20) };
+    return size.x > 0 && size.y > 0 && size.x <= sf::Texture::getMaximumSize() && size.y <= sf::Texture::getMaximumSize();
+  }
+}
+
+std::shared_ptr<Texture> TextureResourceManager::LoadAsync(const string& path) {
+  if (std::shared_ptr<Texture> cached = texturesFromPath.Find(path)) {
+    return cached;
+  }
+
+  sf::Vector2u size;
+
+  if (!ReadPNGSize(path, size)) {
+    return LoadFromFile(path);
+  }
+
+  std::scoped_lock lock(mutex);
+
+  // placeholders stay out of the cache until their pixels are uploaded, LoadFromFile() never returns a blank texture
+  auto pendingIter = pendingTextures.find(path);
+
+  if (pendingIter != pendingTextures.end()) {
+    if (std::shared_ptr<Texture> texture = pendingIter->second.lock()) {
+      // someone else started loading this path first
+      return texture;
+    }
+  }
+
+  sf::Image blank;
+  blank.create(size.x, size.y, sf::Color::Transparent);
+
+  std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+  texture->loadFromImage(blank);
+
+  pendingTextures[path] = texture;
+
+  if (!decodeThread.joinable()) {
+    decodeThread = std::thread(&TextureResourceManager::DecodeWorker, this);
+  }
+
+  PendingTexture pending;
+  pending.path = path;
+  pending.texture = texture;
+  decodeQueue.push_back(std::move(pending));
+  decodeSignal.notify_one();
+
+  return texture;
+}
+
+void TextureResourceManager::DecodeWorker() {
+  std::unique_lock lock(mutex);
+
+  while (true) {
+    decodeSignal.wait(lock, [this] { return stopDecoding || !decodeQueue.empty(); });
+
+    if (stopDecoding) return;
+
+    PendingTexture pending = std::move(decodeQueue.front());
+    decodeQueue.pop_front();
+
+    if (pending.texture.expired()) {
+      ErasePending(pending);
+      continue;
+    }
+
+    lock.unlock();
+    pending.decoded = pending.image.loadFromFile(pending.path);
+    lock.lock();
+
+    uploadQueue.push_back(std::move(pending));
   }
+}
+
+void TextureResourceManager::ErasePending(const PendingTexture& pending) {
+  auto iter = pendingTextures.find(pending.path);
+
+  // LoadAsync() may have replaced an expired placeholder for the same path
+  if (iter == pendingTextures.end()) return;
+
+  if (iter->second.expired() || iter->second.lock() == pending.texture.lock()) {
+    pendingTextures.erase(iter);
+  }
+}
+
+void TextureResourceManager::ProcessPendingUploads() {
+  std::vector<PendingTexture> uploads;
+
+  {
+    std::scoped_lock lock(mutex);
+
+    if (uploadQueue.empty()) return;
+
+    uploads.swap(uploadQueue);
+  }
+
+  for (PendingTexture& pending : uploads) {
+    std::shared_ptr<Texture> texture = pending.texture.lock();
+
+    {
+      std::scoped_lock lock(mutex);
+      ErasePending(pending);
+    }
+
+    if (!texture) continue;
+
+    if (!pending.decoded) {
+      Logger::Logf(LogLevel::critical, "Failed loading texture: %s", pending.path.c_str());
+      continue;
+    }
+
+    if (texture->getSize() == pending.image.getSize()) {
+      texture->update(pending.image);
+    }
+    else {
+      // the file changed since its size was read
+      texture->loadFromImage(pending.image);
+    }
+
+    // if LoadFromFile() loaded this path in the meantime the cache keeps that texture
+    sf::Vector2u size = texture->getSize();
+    texturesFromPath.Insert(pending.path, texture, static_cast<size_t>(size.x) * size.y * 4u);
+
+    Logger::Logf(LogLevel::info, "Loaded texture: %s", pending.path.c_str());
+  }
+}
+
+std::shared_ptr<Texture> TextureResourceManager::LoadIntoAtlas(const string& path) {
+  std::shared_ptr<Texture> texture = LoadFromFile(path);
+
+  if (!atlas || texture->getSize().x == 0 || atlas->Find(texture.get())) {
+    return texture;
+  }
+
+  // reads the pixels back once, only a few textures are drawn from the atlas
+  atlas->Add(path, texture->copyToImage(), texture);
 
   return texture;
 }
 
-TextureResourceManager::TextureResourceManager() {
+void TextureResourceManager::EnableAtlas() {
+  if (atlas) return;
+
+  atlas = std::make_unique<TextureAtlas>();
+}
+
+const TextureAtlas* TextureResourceManager::GetAtlas() const {
+  return atlas.get();
+}
+
+TextureResourceManager::TextureResourceManager() :
+  texturesFromPath("Texture", DEFAULT_MEMORY_BUDGET)
+{
 }
 
 TextureResourceManager::~TextureResourceManager() {
+  {
+    std::scoped_lock lock(mutex);
+    stopDecoding = true;
+  }
+
+  decodeSignal.notify_all();
+
+  if (decodeThread.joinable()) {
+    decodeThread.join();
+  }
 }
@@ -10,12 +10,17 @@
 #include "bnResourcePaths.h"
 #include "bnLogger.h"
 #include "bnCachedResource.h"
+#include "bnTextureAtlas.h"
 
 #include <SFML/Graphics.hpp>
 #include <map>
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <unordered_map>
 
 using std::cerr;
 using std::endl;
@@ -27,6 +32,8 @@ using std::string;
 
 class TextureResourceManager {
 public:
+  static constexpr size_t DEFAULT_MEMORY_BUDGET = 256u * 1024u * 1024u;
+
   TextureResourceManager();
   ~TextureResourceManager();
 
@@ -51,8 +58,71 @@ public:
    */
   std::shared_ptr<Texture> LoadFromFile(string _path);
 
+  /**
+   * @brief Returns a texture right away and decodes the image on a worker thread
+   * @param path Relative path to the application
+   * @return Texture. Transparent and already the size of the image until the pixels are uploaded.
+   *
+   * Only the size is read from the file up front, so sprites can be positioned with the placeholder.
+   * The texture is cached once its pixels are uploaded, until then LoadFromFile() loads the file on its own.
+   * Files that are not PNGs are loaded immediately with LoadFromFile().
+   */
+  std::shared_ptr<Texture> LoadAsync(const string& path);
+
+  /**
+   * @brief Uploads images decoded by LoadAsync() to their textures. Call from the render thread.
+   */
+  void ProcessPendingUploads();
+
+  /**
+  * @brief Unused textures are evicted oldest first while the cache takes more than this
+  * @param bytes estimated as width * height * 4 for every texture
+  */
+  void SetMemoryBudget(size_t bytes);
+
+  /**
+   * @brief Same as LoadFromFile() and packs the texture into a shared atlas page if the atlas is enabled
+   *
+   * Only for textures drawn through a RenderQueue, nothing else draws from the atlas.
+   * The texture is still loaded on its own so it can be used like any other texture.
+   */
+  std::shared_ptr<Texture> LoadIntoAtlas(const string& path);
+
+  /**
+  * @brief Textures loaded with LoadIntoAtlas() are packed into shared atlas pages
+  *
+  * Draw code that batches looks up the atlas region with GetAtlas()
+  */
+  void EnableAtlas();
+
+  /**
+  * @return nullptr if EnableAtlas() was not called
+  */
+  const TextureAtlas* GetAtlas() const;
+
 private:
-  std::mutex mutex;
+  struct PendingTexture {
+    string path;
+    std::weak_ptr<Texture> texture; //!< skipped if the texture was freed before it finished decoding
+    sf::Image image;
+    bool decoded{};
+  };
+
+  void DecodeWorker();
+
+  /**
+   * @brief Forgets the placeholder for this path unless it was replaced. mutex must be held.
+   */
+  void ErasePending(const PendingTexture& pending);
+
+  std::mutex mutex; /**< Guards the decode and upload queues and pending textures */
+  std::condition_variable decodeSignal;
+  std::deque<PendingTexture> decodeQueue;
+  std::vector<PendingTexture> uploadQueue;
+  std::unordered_map<string, std::weak_ptr<Texture>> pendingTextures; /**< Placeholders returned by LoadAsync() that are not cached yet */
+  std::thread decodeThread;
+  bool stopDecoding{};
   vector<string> paths; /**< Paths to all textures. Must be in order of TextureType @see TextureType */
-  map<std::string, CachedResource<Texture>> texturesFromPath; /**< Cache for textures loaded at run-time */
+  ResourceCache<Texture> texturesFromPath; /**< Cache for textures loaded at run-time */
+  std::unique_ptr<TextureAtlas> atlas; /**< Pages small textures are packed into when enabled */
 };
\ No newline at end of file
@@ -122,11 +122,9 @@ void TitleScene::onUpdate(double elapsed)
     if (pm.Size() == 0) {
       std::string path = "resources/ow/prog/";
       std::string msg = "Looks like you need a Player Mod to continue.\nDownload one and put it under:\n\n`resources/\n mods/\n players/`\nThen re-launch to start playing!";
-      sf::Sprite spr;
-      spr.setTexture(*Textures().LoadFromFile(path+"prog_mug.png"));
       currMessage = new Message(msg);
       currMessage->ShowEndMessageCursor();
-      textbox.EnqueMessage(spr, path + "prog_mug.animation", currMessage);
+      textbox.EnqueMessage(Textures().LoadFromFile(path+"prog_mug.png"), path + "prog_mug.animation", currMessage);
       textbox.Open();
       Audio().Play(AudioType::CHIP_DESC, AudioPriority::high);
     }
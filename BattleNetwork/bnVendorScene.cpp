@@ -71,18 +71,22 @@ VendorScene::VendorScene(
 {
   label.setScale(2.f, 2.f);
 
-  moreItems.setTexture(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR));
+  moreItemsTexture = Textures().LoadFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR);
+  moreItems.setTexture(*moreItemsTexture);
   moreItems.setScale(2.f, 2.f);
 
-  wallet.setTexture(*Textures().LoadFromFile("resources/scenes/vendors/price.png"), true);
+  walletTexture = Textures().LoadFromFile("resources/scenes/vendors/price.png");
+  wallet.setTexture(*walletTexture, true);
   wallet.setScale(0.f, 0.f); // hide
   wallet.setPosition(340, 0.f);
 
-  list.setTexture(*Textures().LoadFromFile("resources/scenes/vendors/list.png"), true);
+  listTexture = Textures().LoadFromFile("resources/scenes/vendors/list.png");
+  list.setTexture(*listTexture, true);
   list.setScale(0.f, 0.f); // hide
   list.setPosition(0.f, 0.f);
 
-  cursor.setTexture(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_CURSOR));
+  cursorTexture = Textures().LoadFromFile(TexturePaths::TEXT_BOX_CURSOR);
+  cursor.setTexture(*cursorTexture);
   cursor.setScale(2.f, 2.f);
 
   bg = new VendorBackground;
@@ -46,6 +46,7 @@ private:
   sf::Sprite moreItems;
   sf::Sprite cursor;
   sf::Sprite list;
+  std::shared_ptr<sf::Texture> walletTexture, moreItemsTexture, cursorTexture, listTexture;
   std::string defaultMessage;
   std::shared_ptr<sf::Texture> mugshotTexture;
   sf::Sprite mugshot;
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+/*
+ * Streaming implementation of the XXH64 hash by Yann Collet.
+ * https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+ *
+ * XXH64 is not a cryptographic hash. It is used to detect changed content,
+ * not to defend against content built to collide.
+ *
+ * Usage:
+ *
+ *   XXH64State state;
+ *   XXH64Init(&state, 0);
+ *   XXH64Update(&state, buf, len); // as many times as needed
+ *   uint64_t hash = XXH64Digest(&state);
+ */
+
+struct XXH64State {
+  uint64_t totalLen;
+  uint64_t acc[4];
+  unsigned char buffer[32];
+  size_t bufferSize;
+  uint64_t seed;
+};
+
+namespace detail_xxh64 {
+  constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+  constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+  constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+  constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+  constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+  inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  // byte order independent reads, the hash is defined on little endian values
+  inline uint64_t read64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+  }
+
+  inline uint32_t read32(const unsigned char* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+  }
+
+  inline uint64_t round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME2;
+    acc = rotl(acc, 31);
+    return acc * PRIME1;
+  }
+
+  inline uint64_t mergeRound(uint64_t acc, uint64_t val) {
+    acc ^= round(0, val);
+    return acc * PRIME1 + PRIME4;
+  }
+
+  inline void consumeStripe(uint64_t acc[4], const unsigned char* p) {
+    acc[0] = round(acc[0], read64(p));
+    acc[1] = round(acc[1], read64(p + 8));
+    acc[2] = round(acc[2], read64(p + 16));
+    acc[3] = round(acc[3], read64(p + 24));
+  }
+}
+
+inline void XXH64Init(XXH64State* state, uint64_t seed) {
+  using namespace detail_xxh64;
+
+  std::memset(state, 0, sizeof(XXH64State));
+  state->seed = seed;
+  state->acc[0] = seed + PRIME1 + PRIME2;
+  state->acc[1] = seed + PRIME2;
+  state->acc[2] = seed;
+  state->acc[3] = seed - PRIME1;
+}
+
+inline void XXH64Update(XXH64State* state, const void* data, size_t len) {
+  using namespace detail_xxh64;
+
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* end = p + len;
+
+  state->totalLen += len;
+
+  // top off a partial stripe from the last update first
+  if (state->bufferSize) {
+    size_t fill = 32 - state->bufferSize;
+
+    if (len < fill) {
+      std::memcpy(state->buffer + state->bufferSize, p, len);
+      state->bufferSize += len;
+      return;
+    }
+
+    std::memcpy(state->buffer + state->bufferSize, p, fill);
+    consumeStripe(state->acc, state->buffer);
+    p += fill;
+    state->bufferSize = 0;
+  }
+
+  while (end - p >= 32) {
+    consumeStripe(state->acc, p);
+    p += 32;
+  }
+
+  if (p < end) {
+    state->bufferSize = static_cast<size_t>(end - p);
+    std::memcpy(state->buffer, p, state->bufferSize);
+  }
+}
+
+inline uint64_t XXH64Digest(const XXH64State* state) {
+  using namespace detail_xxh64;
+
+  uint64_t h;
+
+  if (state->totalLen >= 32) {
+    const uint64_t* acc = state->acc;
+    h = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18);
+    h = mergeRound(h, acc[0]);
+    h = mergeRound(h, acc[1]);
+    h = mergeRound(h, acc[2]);
+    h = mergeRound(h, acc[3]);
+  }
+  else {
+    h = state->seed + PRIME5;
+  }
+
+  h += state->totalLen;
+
+  const unsigned char* p = state->buffer;
+  const unsigned char* end = p + state->bufferSize;
+
+  while (end - p >= 8) {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * PRIME1 + PRIME4;
+    p += 8;
+  }
+
+  if (end - p >= 4) {
+    h ^= uint64_t(read32(p)) * PRIME1;
+    h = rotl(h, 23) * PRIME2 + PRIME3;
+    p += 4;
+  }
+
+  while (p < end) {
+    h ^= uint64_t(*p) * PRIME5;
+    h = rotl(h, 11) * PRIME1;
+    p++;
+  }
+
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+
+  return h;
+}
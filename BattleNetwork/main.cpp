@@ -17,6 +17,9 @@
 #include "bnPlayer.h"
 #include "bnEmotions.h"
 #include "bnCardFolder.h"
+#include "bnCompiledAnimation.h"
+#include "bnQueueModRegistration.h"
+#include "bnPackageFingerprint.h"
 #include "stx/string.h"
 #include "stx/result.h"
 #include "cxxopts/cxxopts.hpp"
@@ -25,6 +28,12 @@
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/URI.h>
 #include <Poco/StreamCopier.h>
+#include <chrono>
+
+// TODO: mac os < 10.5 file system support...
+#ifndef __APPLE__
+#include <filesystem>
+#endif
 
 // Launches the standard game with full setup and configuration
 int LaunchGame(Game& g, const cxxopts::ParseResult& results);
@@ -45,6 +54,12 @@ void PrintPackageHash(Game& g, TaskGroup tasks);
 // Reads a zip mod on disk and displays the package ID and hash
 void ReadPackageAndHash(const std::string& path, const std::string& modType);
 
+// Boots and displays how fast each type of mod was installed
+void PrintModLoadBenchmark(TaskGroup tasks);
+
+// Hashes every package folder inside of path with each fingerprint algorithm and displays the timings
+void PrintHashBenchmark(const std::string& path);
+
 static cxxopts::Options options("ONB", "Open Net Battle Engine");
 
 int main(int argc, char** argv) {
@@ -52,8 +67,20 @@ int main(int argc, char** argv) {
   options.add_options()
     ("h,help", "Print all options")
     ("e,errorLevel", "Set the level to filter error messages [silent|info|warning|critical|debug] (default is `critical`)", cxxopts::value<std::string>()->default_value("warning|critical"))
+    ("logfileLevel", "Set the levels written to log.txt, same format as errorLevel", cxxopts::value<std::string>()->default_value("all"))
+    ("logoverflow", "what to do when logs are written faster than they can be saved [block|drop]", cxxopts::value<std::string>()->default_value("block"))
     ("d,debug", "Enable debugging")
     ("s,singlethreaded", "run logic and draw routines in a single, main thread")
+    ("packagehash", "algorithm used to fingerprint packages [md5|content]. Everyone in a match must use the same one", cxxopts::value<std::string>()->default_value("md5"))
+    ("verify-hashes", "ignore remembered package hashes and zip + hash every package again")
+    ("bootworkers", "threads used to run independent boot tasks like audio, graphics and each mod category at the same time, 0 uses every hardware thread and 1 runs them in order", cxxopts::value<int>()->default_value("0"))
+    ("modworkers", "threads used to extract and hash mods at boot, 0 uses every hardware thread and 1 disables threading", cxxopts::value<int>()->default_value("0"))
+    ("sharedlua", "run packages from the same namespace in one shared lua state, each with its own globals, instead of one state per package")
+    ("luagcbudget", "microseconds per frame spent collecting lua garbage after logic and drawing, 0 lets lua collect whenever it allocates", cxxopts::value<int>()->default_value("1000"))
+    ("profilelua", "count time and memory used by each package's scripts, shown during battle and saved as csv when it ends")
+    ("atlas", "pack field tile textures into a shared atlas page so the field draws in fewer batches")
+    ("texturebudget", "megabytes of texture data to keep cached before unused textures are freed", cxxopts::value<int>()->default_value(std::to_string(TextureResourceManager::DEFAULT_MEMORY_BUDGET / (1024 * 1024))))
+    ("audiobudget", "megabytes of sound data to keep cached before unused sounds are freed", cxxopts::value<int>()->default_value(std::to_string(AudioResourceManager::DEFAULT_MEMORY_BUDGET / (1024 * 1024))))
     ("l,locale", "set flair and language to desired target", cxxopts::value<std::string>()->default_value("en"))
     ("p,port", "port for PVP", cxxopts::value<int>()->default_value("0"))
     ("r,remotePort", "remote port for main hub", cxxopts::value<int>()->default_value(std::to_string(NetPlayConfig::OBN_PORT)))
@@ -72,7 +99,10 @@ int main(int argc, char** argv) {
   options.add_options("Utilities")
     ("i,installed", "List the successfully loaded mods and their hashes")
     ("j,hash", "path to a mod .zip anywhere on disk then display the md5 and package id pair to screen", cxxopts::value<std::string>()->default_value(""))
-    ("t,type", "specifies the one type of mod to parse [player|block|card|mob|lib]", cxxopts::value<std::string>()->default_value(""));
+    ("t,type", "specifies the one type of mod to parse [player|block|card|mob|lib]", cxxopts::value<std::string>()->default_value(""))
+    ("compileanimations", "path to a folder to compile every .animation file inside ahead of time", cxxopts::value<std::string>()->default_value(""))
+    ("benchmarkmods", "Boot then display how long each type of mod took to install and the packages per second")
+    ("benchmarkhash", "path to a folder of packages to hash with every fingerprint algorithm then display the timings", cxxopts::value<std::string>()->default_value(""));
 
   // Prevent throwing exceptions on bad input
   options.allow_unrecognised_options();
@@ -110,7 +140,7 @@ int main(int argc, char** argv) {
   return EXIT_SUCCESS;
 }
 
-void ParseErrorLevel(std::string in) {
+uint8_t ParseLogLevels(std::string in, std::string& names) {
   std::map<std::string, bool> settings;
 
   // Parse input tokens
@@ -123,8 +153,6 @@ void ParseErrorLevel(std::string in) {
   }
 
   uint8_t level = LogLevel::silent;
-
-  std::string msg = "Logs will be displayed below. Log level is set to ";
   std::vector<std::string> valid;
 
   auto processSettings = [&settings, &level, &valid](const std::string& key, uint8_t value) {
@@ -147,30 +175,64 @@ void ParseErrorLevel(std::string in) {
     valid.push_back("all");
   }
   
-  std::string validStr = "silent";
+  names = "silent";
 
   for (size_t i = 0; i < valid.size(); i++) {
-    validStr += valid[i];
+    names += valid[i];
 
     if (i + 1u < valid.size()) {
-      validStr += "|";
+      names += "|";
     }
   }
 
+  return level;
+}
+
+void ParseErrorLevel(std::string in) {
+  std::string validStr;
+  uint8_t level = ParseLogLevels(in, validStr);
+
+  std::string msg = "Logs will be displayed below. Log level is set to ";
   msg += "`" + validStr + "`";
   std::cerr << msg << std::endl;
   
   Logger::SetLogLevel(level);
 }
 
+void ConfigureLogFile(const std::string& fileLevels, const std::string& overflow) {
+  std::string validStr;
+  Logger::SetFileLogLevel(ParseLogLevels(fileLevels, validStr));
+
+  if (overflow == "drop") {
+    Logger::SetOverflowPolicy(Logger::OverflowPolicy::drop);
+  }
+  else {
+    if (overflow != "block") {
+      std::cerr << "Unknown log overflow policy `" << overflow << "`, using `block`" << std::endl;
+    }
+
+    Logger::SetOverflowPolicy(Logger::OverflowPolicy::block);
+  }
+}
+
 int LaunchGame(Game& g, const cxxopts::ParseResult& results) {
   g.SeedRand((unsigned int)time(0));
   g.SetCommandLineValues(results);
 
   ParseErrorLevel(g.CommandLineValue<std::string>("errorLevel"));
+  ConfigureLogFile(g.CommandLineValue<std::string>("logfileLevel"), g.CommandLineValue<std::string>("logoverflow"));
 
   g.PrintCommandLineArgs();
 
+  const std::string& hashName = g.CommandLineValue<std::string>("packagehash");
+
+  if (std::optional<PackageFingerprint::Algorithm> algorithm = PackageFingerprint::ParseAlgorithm(hashName)) {
+    PackageFingerprint::SetAlgorithm(*algorithm);
+  }
+  else {
+    Logger::Logf(LogLevel::warning, "Unknown package hash `%s`, using md5", hashName.c_str());
+  }
+
   if (g.GetEndianness() == Endianness::big) {
     Logger::Log(LogLevel::info, "System arch is Big Endian");
   }
@@ -209,6 +271,27 @@ int LaunchGame(Game& g, const cxxopts::ParseResult& results) {
     return EXIT_SUCCESS;
   }
 
+  if (g.CommandLineValue<bool>("benchmarkmods")) {
+    PrintModLoadBenchmark(g.Boot(results));
+
+    return EXIT_SUCCESS;
+  }
+
+  const std::string& animationsPath = g.CommandLineValue<std::string>("compileanimations");
+  if (!animationsPath.empty()) {
+    size_t count = CompiledAnimation::CompileDirectory(animationsPath);
+    std::cout << "Compiled " << count << " animation file(s)" << std::endl;
+
+    return EXIT_SUCCESS;
+  }
+
+  const std::string& benchmarkPath = g.CommandLineValue<std::string>("benchmarkhash");
+  if (!benchmarkPath.empty()) {
+    PrintHashBenchmark(benchmarkPath);
+
+    return EXIT_SUCCESS;
+  }
+
   const std::string& path = g.CommandLineValue<std::string>("hash");
   const std::string& type = g.CommandLineValue<std::string>("type");
   if (!path.empty()) {
@@ -246,12 +329,10 @@ int HandleBattleOnly(Game& g, TaskGroup tasks, const std::string& playerpath, co
 
   // wait for resources to be available for us
   const unsigned int maxtasks = tasks.GetTotalTasks();
-  while (tasks.HasMore()) {
-    const std::string taskname = tasks.GetTaskName();
-    const unsigned int tasknumber = tasks.GetTaskNumber();
-    Logger::Logf(LogLevel::info, "Running %s, [%i/%i]", taskname.c_str(), tasknumber+1u, maxtasks);
-    tasks.DoNextTask();
-  }
+  // tasks can run at the same time, so count them as they complete
+  tasks.Run(nullptr, [maxtasks](const std::string& taskname, unsigned finished) {
+    Logger::Logf(LogLevel::info, "Finished %s, [%u/%u]", taskname.c_str(), finished, maxtasks);
+  });
 
   ResourceHandle handle;
 
@@ -290,7 +371,7 @@ int HandleBattleOnly(Game& g, TaskGroup tasks, const std::string& playerpath, co
     { player, programAdvance, std::move(folder), field, mob->GetBackground() },
     MobBattleProperties::RewardBehavior::take,
     { mob },
-    sf::Sprite(*mugshot),
+    mugshot,
     mugshotAnim,
     emotions,
   };
@@ -413,12 +494,10 @@ void CollectPackageHashBuffer(PackageManagerT& pm, std::string& outStr, size_t&
 void PrintPackageHash(Game& g, TaskGroup tasks) {
   // wait for resources to be available for us
   const unsigned int maxtasks = tasks.GetTotalTasks();
-  while (tasks.HasMore()) {
-    const std::string taskname = tasks.GetTaskName();
-    const unsigned int tasknumber = tasks.GetTaskNumber();
-    Logger::Logf(LogLevel::info, "Running %s, [%i/%i]", taskname.c_str(), tasknumber + 1u, maxtasks);
-    tasks.DoNextTask();
-  }
+  // tasks can run at the same time, so count them as they complete
+  tasks.Run(nullptr, [maxtasks](const std::string& taskname, unsigned finished) {
+    Logger::Logf(LogLevel::info, "Finished %s, [%u/%u]", taskname.c_str(), finished, maxtasks);
+  });
 
   BlockPackageManager& blocks = g.BlockPackagePartitioner().GetPartition(Game::LocalPartition);
   PlayerPackageManager& players = g.PlayerPackagePartitioner().GetPartition(Game::LocalPartition);
@@ -450,6 +529,121 @@ void PrintPackageHash(Game& g, TaskGroup tasks) {
   std::cout << libStr << std::endl;
 }
 
+void PrintModLoadBenchmark(TaskGroup tasks) {
+  auto start = std::chrono::steady_clock::now();
+
+  tasks.Run();
+
+  double bootSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  size_t totalPackages{};
+
+  std::cout << "category, workers, packages, failures, extract (s), scripts (s), hash (s), commit (s), total (s), packages/s" << std::endl;
+
+  for (const ModRegistration::Stats& stats : ModRegistration::GetStats()) {
+    double throughput = stats.totalSeconds > 0.0 ? stats.packages / stats.totalSeconds : 0.0;
+    totalPackages += stats.packages;
+
+    std::cout << stats.category << ", "
+      << stats.workers << ", "
+      << stats.packages << ", "
+      << stats.failures << ", "
+      << stats.extractSeconds << ", "
+      << stats.parseSeconds << ", "
+      << stats.hashSeconds << ", "
+      << stats.commitSeconds << ", "
+      << stats.totalSeconds << ", "
+      << throughput << std::endl;
+  }
+
+  std::cout << "Booted with " << totalPackages << " package(s) in " << bootSeconds << " secs" << std::endl;
+}
+
+void PrintHashBenchmark(const std::string& path) {
+#ifndef __APPLE__
+  using Clock = std::chrono::steady_clock;
+  using Algorithm = PackageFingerprint::Algorithm;
+
+  const Algorithm algorithms[] = { Algorithm::md5, Algorithm::content };
+  double totalSeconds[2]{};
+  uint64_t totalBytes{};
+
+  std::error_code ec;
+  std::vector<std::filesystem::path> packages;
+
+  for (const auto& entry : std::filesystem::directory_iterator(path, ec)) {
+    if (entry.is_directory()) {
+      packages.push_back(entry.path());
+    }
+  }
+
+  if (ec) {
+    std::cerr << "Could not read " << path << std::endl;
+    return;
+  }
+
+  std::sort(packages.begin(), packages.end());
+
+  std::cout << "package, bytes, md5 (s), content (s), md5 MB/s, content MB/s" << std::endl;
+
+  for (size_t index = 0; index < packages.size(); index++) {
+    const std::filesystem::path& package = packages[index];
+    std::string packagePath = package.generic_string();
+    uint64_t bytes{};
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(package, ec)) {
+      if (entry.is_regular_file()) {
+        bytes += entry.file_size();
+      }
+    }
+
+    // the zip goes to the temp directory so the benchmark leaves the packages untouched
+    std::string zipPath = (std::filesystem::temp_directory_path(ec) / (package.filename().generic_string() + ".zip")).generic_string();
+
+    // read every file once first so neither algorithm pays for a cold page cache,
+    // and take turns going first so neither always runs right after the other
+    PackageFingerprint::Hash(packagePath, Algorithm::content);
+
+    double seconds[2]{};
+    bool failed = false;
+
+    for (size_t n = 0; n < 2; n++) {
+      size_t i = (index + n) % 2;
+      Clock::time_point start = Clock::now();
+      stx::result_t<std::string> hash = PackageFingerprint::Hash(packagePath, algorithms[i], zipPath);
+      seconds[i] = std::chrono::duration<double>(Clock::now() - start).count();
+
+      if (hash.is_error()) {
+        std::cerr << package.filename().generic_string() << ": " << hash.error_cstr() << std::endl;
+        failed = true;
+      }
+    }
+
+    std::filesystem::remove(zipPath, ec);
+
+    if (failed) continue;
+
+    auto throughput = [bytes](double secs) {
+      return secs > 0.0 ? (bytes / (1024.0 * 1024.0)) / secs : 0.0;
+    };
+
+    std::cout << package.filename().generic_string() << ", "
+      << bytes << ", "
+      << seconds[0] << ", "
+      << seconds[1] << ", "
+      << throughput(seconds[0]) << ", "
+      << throughput(seconds[1]) << std::endl;
+
+    totalBytes += bytes;
+    totalSeconds[0] += seconds[0];
+    totalSeconds[1] += seconds[1];
+  }
+
+  std::cout << "Hashed " << totalBytes << " bytes. md5: " << totalSeconds[0] << " secs, content: " << totalSeconds[1] << " secs" << std::endl;
+#else
+  std::cerr << "System filedirectory utils not supported on APPLE" << std::endl;
+#endif
+}
+
 template<typename ScriptedDataT, typename PackageManagerT>
 void ReadPackageStep(PackageManagerT& pm, const std::string& path, std::string& id, std::string& hash) {
   stx::result_t<std::string> maybe_id = pm.template LoadPackageFromZip<ScriptedDataT>(path);
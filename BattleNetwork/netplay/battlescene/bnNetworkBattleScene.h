@@ -68,7 +68,7 @@ struct NetworkPlayerSpawnData {
 
 struct NetworkBattleSceneProps {
   BattleSceneBaseProps base;
-  sf::Sprite mug; // speaker mugshot
+  std::shared_ptr<sf::Texture> mug; // speaker mugshot
   Animation anim; // mugshot animation
   std::shared_ptr<sf::Texture> emotion; // emotion atlas image
   std::shared_ptr<Netplay::PacketProcessor> packetProcessor;
@@ -614,7 +614,7 @@ void MatchMakingScene::onUpdate(double elapsed) {
 
       NetworkBattleSceneProps props = {
         { player, pa, std::move(copy), std::make_shared<Field>(6, 3), std::make_shared<SecretBackground>() },
-        sf::Sprite(*mugshot),
+        mugshot,
         mugshotAnim,
         emotions,
         packetProcessor->GetProxy(),
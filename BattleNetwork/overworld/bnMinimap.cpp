@@ -33,14 +33,107 @@ static float resolveTileHeight(Overworld::Map& map, sf::Vector2f mapScreenUnitDi
   return targetTileHeight;
 }
 
+const int CHUNK_SIZE = 16; // in tiles
+
+/**
+  layer1= 152 144 224
+  layer2= 176 168 240 diff = 24 24 16
+  layer3= 208 200 248 diff = 24 32  8
+                             ---------
+                             0  +8 -8
+
+  potential layer4= 208, 208, 240? ??
+**/
+const auto LAYER1_COLOR = sf::Color(152, 144, 224);
+const auto LAYER_MAX_COLOR = sf::Color(208, 208, 240);
+
+static sf::Color lerpLayerColor(int index, int maxCount) {
+  if (index > maxCount) {
+    index = maxCount;
+  }
+
+  float delta = ((float)index / (float)maxCount);
+
+  float r = (1.f - delta) * LAYER1_COLOR.r + (delta * LAYER_MAX_COLOR.r);
+  float g = (1.f - delta) * LAYER1_COLOR.g + (delta * LAYER_MAX_COLOR.g);
+  float b = (1.f - delta) * LAYER1_COLOR.b + (delta * LAYER_MAX_COLOR.b);
+
+  return sf::Color(sf::Uint8(r), sf::Uint8(g), sf::Uint8(b));
+}
+
+// stairs are tinted green and are not masked into a diamond
+static sf::Color stairsColor(sf::Color layerColor) {
+  return sf::Color(
+    sf::Uint8(layerColor.r * 0.6f),
+    sf::Uint8(std::min(layerColor.g * 1.2f, 255.f)),
+    sf::Uint8(layerColor.b * 0.6f)
+  );
+}
+
+// clips a convex polygon against an axis aligned rect (Sutherland-Hodgman)
+static std::vector<sf::Vector2f> clipToRect(std::vector<sf::Vector2f> polygon, const sf::FloatRect& rect) {
+  auto clipEdge = [&polygon](auto inside, auto intersect) {
+    std::vector<sf::Vector2f> output;
+    output.reserve(polygon.size() + 4);
+
+    for (size_t i = 0; i < polygon.size(); i++) {
+      const sf::Vector2f& current = polygon[i];
+      const sf::Vector2f& previous = polygon[(i + polygon.size() - 1) % polygon.size()];
+
+      if (inside(current)) {
+        if (!inside(previous)) {
+          output.push_back(intersect(previous, current));
+        }
+
+        output.push_back(current);
+      }
+      else if (inside(previous)) {
+        output.push_back(intersect(previous, current));
+      }
+    }
+
+    polygon = std::move(output);
+  };
+
+  auto atX = [](float x) {
+    return [x](const sf::Vector2f& a, const sf::Vector2f& b) {
+      float t = (x - a.x) / (b.x - a.x);
+      return sf::Vector2f(x, a.y + (b.y - a.y) * t);
+    };
+  };
+
+  auto atY = [](float y) {
+    return [y](const sf::Vector2f& a, const sf::Vector2f& b) {
+      float t = (y - a.y) / (b.y - a.y);
+      return sf::Vector2f(a.x + (b.x - a.x) * t, y);
+    };
+  };
+
+  float left = rect.left, top = rect.top;
+  float right = rect.left + rect.width, bottom = rect.top + rect.height;
+
+  clipEdge([left](const sf::Vector2f& p) { return p.x >= left; }, atX(left));
+  clipEdge([right](const sf::Vector2f& p) { return p.x <= right; }, atX(right));
+  clipEdge([top](const sf::Vector2f& p) { return p.y >= top; }, atY(top));
+  clipEdge([bottom](const sf::Vector2f& p) { return p.y <= bottom; }, atY(bottom));
+
+  return polygon;
+}
+
+bool Overworld::Minimap::TileSnapshot::operator==(const TileSnapshot& other) const {
+  return texture == other.texture &&
+    textureRect == other.textureRect &&
+    drawingOffset == other.drawingOffset &&
+    flippedHorizontal == other.flippedHorizontal &&
+    flippedVertical == other.flippedVertical &&
+    rotated == other.rotated &&
+    stairs == other.stairs;
+}
+
 void Overworld::Minimap::Update(const std::string& name, Map& map)
 {
   this->name = name;
 
-  // prepare a render texture to write to
-  sf::RenderTexture texture;
-  sf::RenderStates states;
-
   const auto screenSize = sf::Vector2i{ 240, 160 };
   auto mapScreenUnitDimensions = sf::Vector2f(
     map.WorldToScreen({ (float)map.GetCols(), 0.0f }).x - map.WorldToScreen({ 0.0f, (float)map.GetRows() }).x,
@@ -66,31 +159,6 @@ void Overworld::Minimap::Update(const std::string& name, Map& map)
   // texture does not fit on screen, allow large map controls
   largeMapControls = textureSize.x > screenSize.x || textureSize.y > screenSize.y;
 
-  if (!texture.create(textureSize.x, textureSize.y)) return;
-
-  // fill with background color
-  texture.clear(sf::Color(0,0,0,0));
-
-  /**
-  layer1= 152 144 224
-  layer2= 176 168 240 diff = 24 24 16
-  layer3= 208 200 248 diff = 24 32  8
-                             ---------
-                             0  +8 -8
-
-  potential layer4= 208, 208, 240? ??
-  **/
-
-  sf::Color layer1Color = sf::Color(152, 144, 224);
-  sf::Color layerMaxColor = sf::Color(208, 208, 240);
-
-  sf::Color edge1Color = sf::Color(120, 112, 192);
-  sf::Color edgeMaxColor = sf::Color(160, 152, 224); // sf::Color(168, 160, 240);
-
-    // shader pass transforms opaque pixels into purple hues
-  static ResourceHandle handle;
-  states.shader = handle.Shaders().GetShader(ShaderType::MINIMAP_COLOR);
-
   // guestimate best fit "center" of the map
   auto layerDimensions = map.TileToWorld({ (float)map.GetCols(), (float)map.GetRows() });
   sf::Vector3f mapDimensions = {
@@ -99,68 +167,288 @@ void Overworld::Minimap::Update(const std::string& name, Map& map)
   };
 
   // move the map to the center of the screen and fit
-  // TODO: chunk the minimap for large map
   sf::Vector2f center = map.WorldToScreen(sf::Vector3f(mapDimensions. x, mapDimensions.y, mapDimensions.z * 2.0f) * 0.5f) * scaling;
   offset = center;
 
-  const int maxLayerCount = (int)map.GetLayerCount();
+  sf::Transform transform;
+  transform.translate((240.f * 0.5f) - center.x, (160.f * 0.5f) - center.y);
+  transform.scale(scaling, scaling);
+
+  auto cols = map.GetCols();
+  auto rows = map.GetRows();
+  auto layerCount = map.GetLayerCount();
+
+  bool sameLayout =
+    bakedSize == textureSize &&
+    mapSize == sf::Vector2u(cols, rows) &&
+    mapLayerCount == layerCount &&
+    bakedScaling == scaling &&
+    bakedCenter == center;
+
+  if (!sameLayout) {
+    // everything moved, throw away the old geometry
+    bakedSize = textureSize;
+    mapSize = sf::Vector2u(cols, rows);
+    mapLayerCount = layerCount;
+    bakedScaling = scaling;
+    bakedCenter = center;
+    bakeTransform = transform;
+    chunkCount = sf::Vector2i((cols + CHUNK_SIZE - 1) / CHUNK_SIZE, (rows + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    layerChunks.assign(layerCount, std::vector<TileChunk>(chunkCount.x * chunkCount.y));
+    layerSnapshots.assign(layerCount, std::vector<TileSnapshot>(cols * rows));
+  }
+
+  // compare against what was baked last time and only rebuild chunks that changed
+  bool dirty = !sameLayout;
+
+  for (size_t i = 0; i < layerCount; i++) {
+    auto& snapshots = layerSnapshots[i];
+    auto& chunks = layerChunks[i];
 
-  // apply transforms
-  states.transform.translate((240.f * 0.5f) - center.x, (160.f * 0.5f) - center.y);
-  states.transform.scale(scaling, scaling);
+    for (int row = 0; row < (int)rows; row++) {
+      for (int col = 0; col < (int)cols; col++) {
+        auto snapshot = TakeSnapshot(map, i, col, row);
+        auto& baked = snapshots[row * cols + col];
 
-  // draw. every layer passes through the shader
-  for (auto i = 0; i < maxLayerCount; i++) {
-    auto lerpColor = [](int index, int maxCount, sf::Color minColor, sf::Color maxColor) {
-      if (index > maxCount) {
-        index = maxCount;
+        if (snapshot == baked) continue;
+
+        baked = snapshot;
+        chunks[(row / CHUNK_SIZE) * chunkCount.x + (col / CHUNK_SIZE)].dirty = true;
+        dirty = true;
       }
+    }
+  }
 
-      float delta = ((float)index / (float)maxCount);
+  // a bake that could not create its render textures is tried again
+  if (dirty || !colorPass) {
+    Bake(map);
+  }
 
-      float r = (1.f - delta) * minColor.r + (delta * maxColor.r);
-      float g = (1.f - delta) * minColor.g + (delta * maxColor.g);
-      float b = (1.f - delta) * minColor.b + (delta * maxColor.b);
+  FindMapMarkers(map);
+}
 
-      return sf::Glsl::Vec4(r / 255.f, g / 255.f, b / 255.f, 1.f);
-    };
+Overworld::Minimap::TileSnapshot Overworld::Minimap::TakeSnapshot(Map& map, size_t index, int col, int row) {
+  TileSnapshot snapshot;
+
+  auto tile = map.GetLayer(index).GetTile(col, row);
+  if (!tile || tile->gid == 0) return snapshot;
+
+  auto tileMeta = map.GetTileMeta(tile->gid);
+
+  // failed to load tile
+  if (tileMeta == nullptr) return snapshot;
+
+  // hidden
+  if (tileMeta->type == TileType::invisible) return snapshot;
 
-    states.shader->setUniform("finalColor", lerpColor(i, maxLayerCount, layer1Color, layerMaxColor));
+  if (index > 0 && map.IgnoreTileAbove((float)col, (float)row, (int)index - 1)) return snapshot;
 
-    // draw layer (Applies masking)
-    DrawLayer(texture, *states.shader, states, map, i);
+  auto tileset = map.GetTileset(tile->gid);
+
+  // only tiles drawn with the texture of their tileset
+  if (!tileset || !tileset->texture || tileMeta->sprite.getTexture() != tileset->texture.get()) return snapshot;
+
+  snapshot.texture = tileset->texture;
+  snapshot.textureRect = tileMeta->sprite.getTextureRect();
+  snapshot.drawingOffset = tileMeta->drawingOffset;
+  snapshot.flippedHorizontal = tile->flippedHorizontal;
+  snapshot.flippedVertical = tile->flippedVertical;
+  snapshot.rotated = tile->rotated;
+  snapshot.stairs = tileMeta->type == TileType::stairs;
+
+  return snapshot;
+}
+
+void Overworld::Minimap::Bake(Map& map) {
+  auto tileSize = map.GetTileSize();
+  auto layerCount = (int)mapLayerCount;
+  auto textureSize = sf::Vector2u(bakedSize);
+
+  // chunks stay dirty until they can be drawn
+  if (!colorPass || colorPass->getSize() != textureSize) {
+    colorPass = std::make_shared<sf::RenderTexture>();
+    edgePass = std::make_shared<sf::RenderTexture>();
+
+    if (!colorPass->create(textureSize.x, textureSize.y) || !edgePass->create(textureSize.x, textureSize.y)) {
+      colorPass = edgePass = nullptr;
+      return;
+    }
+  }
+
+  for (int i = 0; i < layerCount; i++) {
+    auto& chunks = layerChunks[i];
+
+    for (int y = 0; y < chunkCount.y; y++) {
+      for (int x = 0; x < chunkCount.x; x++) {
+        auto& chunk = chunks[y * chunkCount.x + x];
+
+        if (chunk.dirty) {
+          BuildChunk(map, i, x, y, chunk);
+        }
+      }
+    }
+  }
+
+  // fill with background color
+  colorPass->clear(sf::Color(0, 0, 0, 0));
+
+  // shader pass transforms opaque pixels into purple hues
+  static ResourceHandle handle;
+  sf::RenderStates states;
+  states.shader = handle.Shaders().GetShader(ShaderType::MINIMAP_COLOR);
+  states.transform = bakeTransform;
+
+  // draw. every layer passes through the shader, one draw per chunk and tileset
+  for (int i = 0; i < layerCount; i++) {
+    for (auto& chunk : layerChunks[i]) {
+      for (auto& [texture, vertices] : chunk.batches) {
+        states.texture = texture;
+        colorPass->draw(vertices, states);
+      }
+    }
 
     // iso layers are offset (prepare for the next layer)
     states.transform.translate(0.f, -tileSize.y * 0.5f);
   }
 
-  // Grab image data to make a texture
-    // NOTE: gpu <-> cpu is a costly process. do this sparringly.
-  texture.display();
-  sf::Texture tempTex = texture.getTexture();
-  sf::Sprite temp(tempTex);
+  colorPass->display();
 
-  // do a second pass for edge detection
+  // do a second pass for edge detection, drawn over the colored map
+  sf::Sprite colored(colorPass->getTexture());
+
+  edgePass->clear(sf::Color(0, 0, 0, 0));
+  edgePass->draw(colored, sf::RenderStates(sf::BlendNone));
+
+  states = sf::RenderStates::Default;
   states.shader = handle.Shaders().GetShader(ShaderType::MINIMAP_EDGE);
-  states.transform = sf::Transform::Identity;
   states.shader->setUniform("resolutionW", (float)textureSize.x);
   states.shader->setUniform("resolutionH", (float)textureSize.y);
-  texture.draw(temp, states);
+  edgePass->draw(colored, states);
 
-  texture.display();
+  edgePass->display();
 
-  // set the final texture
-  bakedMap.setTexture(std::make_shared<sf::Texture>(texture.getTexture()));
+  // set the final texture, sharing ownership with the render texture to avoid a gpu copy
+  bakedMap.setTexture(std::shared_ptr<sf::Texture>(edgePass, const_cast<sf::Texture*>(&edgePass->getTexture())));
+}
 
-  FindMapMarkers(map);
+void Overworld::Minimap::BuildChunk(Map& map, size_t index, int chunkX, int chunkY, TileChunk& chunk) {
+  chunk.batches.clear();
+  chunk.dirty = false;
+
+  auto tileSize = map.GetTileSize();
+  auto& snapshots = layerSnapshots[index];
+  auto layerColor = lerpLayerColor((int)index, (int)mapLayerCount);
+
+  int startRow = chunkY * CHUNK_SIZE;
+  int startCol = chunkX * CHUNK_SIZE;
+  int endRow = std::min(startRow + CHUNK_SIZE, (int)mapSize.y);
+  int endCol = std::min(startCol + CHUNK_SIZE, (int)mapSize.x);
+
+  std::vector<sf::Vector2f> polygon;
+
+  for (int i = startRow; i < endRow; i++) {
+    for (int j = startCol; j < endCol; j++) {
+      auto& snapshot = snapshots[i * mapSize.x + j];
+
+      if (!snapshot.texture) continue;
+
+      const auto subRect = snapshot.textureRect;
+
+      // same placement the overworld uses for the tile sprite
+      sf::Transformable tileTransform;
+      tileTransform.setOrigin(sf::Vector2f(sf::Vector2i(
+        subRect.width / 2,
+        tileSize.y / 2
+      )));
+
+      sf::Vector2i pos((j * tileSize.x) / 2, i * tileSize.y);
+      auto ortho = map.WorldToScreen(sf::Vector2f(pos));
+      auto tileOffset = sf::Vector2f(sf::Vector2i(
+        -tileSize.x / 2 + subRect.width / 2,
+        tileSize.y + tileSize.y / 2 - subRect.height
+      ));
+
+      tileTransform.setPosition(ortho + snapshot.drawingOffset + tileOffset);
+      tileTransform.setRotation(snapshot.rotated ? 90.0f : 0.0f);
+      tileTransform.setScale(
+        snapshot.flippedHorizontal ? -1.0f : 1.0f,
+        snapshot.flippedVertical ? -1.0f : 1.0f
+      );
+
+      auto localBounds = sf::FloatRect(0.f, 0.f, (float)std::abs(subRect.width), (float)std::abs(subRect.height));
+
+      polygon.clear();
+
+      if (snapshot.stairs) {
+        polygon.push_back({ localBounds.left, localBounds.top });
+        polygon.push_back({ localBounds.width, localBounds.top });
+        polygon.push_back({ localBounds.width, localBounds.height });
+        polygon.push_back({ localBounds.left, localBounds.height });
+      }
+      else {
+        // diamond shaped mask around the base of the tile, in texture space
+        auto center = sf::Vector2f(float(subRect.left), float(subRect.top));
+
+        if (snapshot.flippedHorizontal) {
+          center.x += float(subRect.width) - (tileSize.x / 2.0f);
+          center.x += snapshot.drawingOffset.x;
+        }
+        else {
+          center.x += tileSize.x / 2.0f;
+          center.x += -snapshot.drawingOffset.x;
+        }
+
+        if (snapshot.flippedVertical) {
+          center.y += tileSize.y / 2.0f;
+          center.y += snapshot.drawingOffset.y;
+        }
+        else {
+          center.y += subRect.height - (tileSize.y / 2.0f);
+          center.y += -snapshot.drawingOffset.y;
+        }
+
+        center -= sf::Vector2f(float(subRect.left), float(subRect.top));
+
+        float halfWidth = (tileSize.x + 1) * 0.5f;
+        float halfHeight = (tileSize.y + 1) * 0.5f;
+
+        polygon = clipToRect({
+          { center.x, center.y - halfHeight },
+          { center.x + halfWidth, center.y },
+          { center.x, center.y + halfHeight },
+          { center.x - halfWidth, center.y }
+        }, localBounds);
+      }
+
+      if (polygon.size() < 3) continue;
+
+      auto& vertices = chunk.batches[snapshot.texture.get()];
+      vertices.setPrimitiveType(sf::Triangles);
+
+      const sf::Transform& transform = tileTransform.getTransform();
+      sf::Color color = snapshot.stairs ? stairsColor(layerColor) : layerColor;
+
+      auto makeVertex = [&](const sf::Vector2f& local) {
+        return sf::Vertex(
+          transform.transformPoint(local),
+          color,
+          sf::Vector2f(subRect.left + local.x, subRect.top + local.y)
+        );
+      };
+
+      // fan triangulation, the clipped polygon is always convex
+      for (size_t k = 1; k + 1 < polygon.size(); k++) {
+        vertices.append(makeVertex(polygon[0]));
+        vertices.append(makeVertex(polygon[k]));
+        vertices.append(makeVertex(polygon[k + 1]));
+      }
+    }
+  }
 }
 
 void Overworld::Minimap::FindMapMarkers(Map& map) {
   // remove old map markers
-  for(auto& marker : mapMarkers) {
-    bakedMap.RemoveNode(marker.get());
-  }
-
   mapMarkers.clear();
 
   // add new markers
@@ -260,90 +548,9 @@ void Overworld::Minimap::FindObjectMarkers(Map& map) {
   }
 }
 
-void Overworld::Minimap::DrawLayer(sf::RenderTarget& target, sf::Shader& shader, sf::RenderStates states, Overworld::Map& map, size_t index) {
-  auto& layer = map.GetLayer(index);
-
-  // TODO: render SOME objects that are overlaying the map
-  // if (!layer.IsVisible()) return;
-
-  int rows = (int)map.GetRows();
-  int cols = (int)map.GetCols();
-  auto tileSize = map.GetTileSize();
-
-  for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < cols; j++) {
-      auto tile = layer.GetTile(j, i);
-      if (tile->gid == 0) continue;
-
-      auto tileMeta = map.GetTileMeta(tile->gid);
-
-      // failed to load tile
-      if (tileMeta == nullptr) continue;
-
-      // hidden
-      if (tileMeta->type == TileType::invisible) continue;
-
-      if(index > 0 && map.IgnoreTileAbove((float)j, (float)i, (int)index - 1)) continue;
-
-      auto& tileSprite = tileMeta->sprite;
-      const auto subRect = tileSprite.getTextureRect();
-
-      const auto originalOrigin = tileSprite.getOrigin();
-      tileSprite.setOrigin(sf::Vector2f(sf::Vector2i(
-        subRect.width / 2,
-        tileSize.y / 2
-      )));
-
-      sf::Vector2i pos((j * tileSize.x) / 2, i * tileSize.y);
-      auto ortho = map.WorldToScreen(sf::Vector2f(pos));
-      auto tileOffset = sf::Vector2f(sf::Vector2i(
-        -tileSize.x / 2 + subRect.width / 2,
-        tileSize.y + tileSize.y / 2 - subRect.height
-      ));
-
-      tileSprite.setPosition(ortho + tileMeta->drawingOffset + tileOffset);
-      tileSprite.setRotation(tile->rotated ? 90.0f : 0.0f);
-      tileSprite.setScale(
-        tile->flippedHorizontal ? -1.0f : 1.0f,
-        tile->flippedVertical ? -1.0f : 1.0f
-      );
-
-      // pass info to shader
-      auto center = sf::Vector2f(float(subRect.left), float(subRect.top));
-
-      if(tile->flippedHorizontal) {
-        center.x += float(subRect.width) - (tileSize.x / 2.0f);
-        center.x += tileMeta->drawingOffset.x;
-      } else {
-        center.x += tileSize.x / 2.0f;
-        center.x += -tileMeta->drawingOffset.x;
-      }
-
-      if (tile->flippedVertical) {
-        center.y += tileSize.y / 2.0f;
-        center.y += tileMeta->drawingOffset.y;
-      } else {
-        center.y += subRect.height - (tileSize.y / 2.0f);
-        center.y += -tileMeta->drawingOffset.y;
-      }
-
-      sf::Vector2f sizeUv(tileSprite.getTexture()->getSize());
-      shader.setUniform("center", sf::Glsl::Vec2(center.x / sizeUv.x, center.y / sizeUv.y));
-      shader.setUniform("tileSize", sf::Glsl::Vec2((tileSize.x + 1) / sizeUv.x, (tileSize.y + 1) / sizeUv.y));
-      shader.setUniform("mask", tileMeta->type != TileType::stairs);
-
-      // draw
-      target.draw(tileSprite, states);
-
-      // reset origin
-      tileSprite.setOrigin(originalOrigin);
-    }
-  }
-}
-
 Overworld::Minimap::Minimap()
 {
-  auto markerTexture = Textures().LoadFromFile("resources/ow/minimap/markers.png");
+  markerTexture = Textures().LoadFromFile("resources/ow/minimap/markers.png");
   auto markerAnimation = Animation("resources/ow/minimap/markers.animation");
 
   auto initMarker = [&] (SpriteProxyNode& node, const std::string& state) {
@@ -421,8 +628,6 @@ void Overworld::Minimap::SetPlayerPosition(const sf::Vector2f& pos, bool isConce
 
 void Overworld::Minimap::AddPlayerMarker(std::shared_ptr<Overworld::Minimap::PlayerMarker> marker) {
   CopyFrame(*marker, player);
-  marker->SetLayer(-1);
-  bakedMap.AddNode(marker);
   playerMarkers.push_back(marker);
 }
 
@@ -440,16 +645,10 @@ void Overworld::Minimap::RemovePlayerMarker(std::shared_ptr<Overworld::Minimap::
   if (it != playerMarkers.end()) {
     playerMarkers.erase(it);
   }
-
-  bakedMap.RemoveNode(playerMarker.get());
 }
 
 void Overworld::Minimap::ClearIcons()
 {
-  for(auto& marker : mapMarkers) {
-    bakedMap.RemoveNode(marker.get());
-  }
-
   mapMarkers.clear();
 }
 
@@ -541,8 +740,6 @@ void Overworld::Minimap::AddMarker(const std::shared_ptr<SpriteProxyNode>& marke
 
   auto newpos = pos * this->scaling;
   marker->setPosition(newpos.x + (240.f * 0.5f) - offset.x, newpos.y + (160.f * 0.5f) - offset.y);
-  marker->SetLayer(-1);
-  bakedMap.AddNode(marker);
 }
 
 void Overworld::Minimap::Open() {
@@ -581,12 +778,63 @@ void Overworld::Minimap::HandleInput(InputManager& input, sf::Vector2f mousePos)
   Pan(panningOffset);
 }
 
+static void AppendMarker(sf::VertexArray& batch, const sf::Transform& parent, const SpriteProxyNode& marker) {
+  if (marker.IsHidden()) return;
+
+  const sf::Sprite& sprite = marker.getSpriteConst();
+  const sf::IntRect& rect = sprite.getTextureRect();
+  const sf::Color& color = sprite.getColor();
+
+  sf::Transform transform = parent * marker.getTransform() * sprite.getTransform();
+
+  float width = (float)std::abs(rect.width);
+  float height = (float)std::abs(rect.height);
+  float left = (float)rect.left;
+  float right = left + rect.width;
+  float top = (float)rect.top;
+  float bottom = top + rect.height;
+
+  sf::Vertex corners[4] = {
+    sf::Vertex(transform.transformPoint(0.f, 0.f), color, { left, top }),
+    sf::Vertex(transform.transformPoint(width, 0.f), color, { right, top }),
+    sf::Vertex(transform.transformPoint(width, height), color, { right, bottom }),
+    sf::Vertex(transform.transformPoint(0.f, height), color, { left, bottom })
+  };
+
+  batch.append(corners[0]);
+  batch.append(corners[1]);
+  batch.append(corners[2]);
+  batch.append(corners[0]);
+  batch.append(corners[2]);
+  batch.append(corners[3]);
+}
+
 void Overworld::Minimap::draw(sf::RenderTarget& surface, sf::RenderStates states) const
 {
   states.transform *= getTransform();
   surface.draw(rectangle, states);
   surface.draw(this->bakedMap, states);
-  surface.draw(this->player, states);
+
+  // all markers share one texture, draw them as a single batch
+  // clear() keeps the vertex storage around between frames
+  markerBatch.clear();
+
+  const sf::Transform& mapTransform = bakedMap.getTransform();
+
+  for (auto& marker : mapMarkers) {
+    AppendMarker(markerBatch, mapTransform, *marker);
+  }
+
+  for (auto& marker : playerMarkers) {
+    AppendMarker(markerBatch, mapTransform, *marker);
+  }
+
+  AppendMarker(markerBatch, sf::Transform::Identity, this->player);
+
+  sf::RenderStates markerStates = states;
+  markerStates.texture = markerTexture.get();
+  surface.draw(markerBatch, markerStates);
+
   surface.draw(this->overlay, states);
 
   if (!largeMapControls) return;
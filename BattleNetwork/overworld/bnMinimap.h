@@ -4,11 +4,35 @@
 #include "bnOverworldMap.h"
 #include "bnOverworldMenu.h"
 #include <SFML/Graphics.hpp>
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace Overworld {
   class Minimap : public Menu, public sf::Transformable, public ResourceHandle {
   private:
+    /**
+    * @brief Everything that affects how a single tile appears on the minimap
+    * If the snapshot of a tile is unchanged after a map reload, its chunk does not need to be rebuilt
+    */
+    struct TileSnapshot {
+      std::shared_ptr<sf::Texture> texture; //!< held so a new texture can never reuse its address, nullptr if the tile is not drawn
+      sf::IntRect textureRect{};
+      sf::Vector2f drawingOffset{};
+      bool flippedHorizontal{}, flippedVertical{}, rotated{}, stairs{};
+
+      bool operator==(const TileSnapshot& other) const;
+      bool operator!=(const TileSnapshot& other) const { return !(*this == other); }
+    };
+
+    /**
+    * @brief A square of tiles in a layer baked into one vertex array per tileset texture
+    */
+    struct TileChunk {
+      bool dirty{ true };
+      std::map<const sf::Texture*, sf::VertexArray> batches;
+    };
+
     bool largeMapControls{};
     float scaling{}; //!< scaling used to fit everything on the screen
     sf::Vector2f offset{}; //!< screen offsets to align icons correctly
@@ -19,7 +43,21 @@ namespace Overworld {
     SpriteProxyNode player, home, warp, board, shop, conveyor, arrow, overlay, overlayArrows, bakedMap;
     std::vector<std::shared_ptr<SpriteProxyNode>> playerMarkers;
     std::vector<std::shared_ptr<SpriteProxyNode>> mapMarkers;
-    void DrawLayer(sf::RenderTarget& target, sf::Shader& shader, sf::RenderStates states, Map& map, size_t index);
+    std::shared_ptr<sf::Texture> markerTexture;
+    mutable sf::VertexArray markerBatch{ sf::Triangles }; //!< every marker is drawn in one call
+    sf::Vector2u mapSize{}; //!< cols, rows of the baked map
+    size_t mapLayerCount{};
+    sf::Vector2i chunkCount{};
+    sf::Vector2i bakedSize{};
+    float bakedScaling{};
+    sf::Vector2f bakedCenter{};
+    sf::Transform bakeTransform;
+    std::vector<std::vector<TileChunk>> layerChunks; //!< [layer][chunk]
+    std::vector<std::vector<TileSnapshot>> layerSnapshots; //!< [layer][tile]
+    std::shared_ptr<sf::RenderTexture> colorPass, edgePass;
+    TileSnapshot TakeSnapshot(Map& map, size_t layer, int col, int row);
+    void BuildChunk(Map& map, size_t layer, int chunkX, int chunkY, TileChunk& chunk);
+    void Bake(Map& map);
     void FindMapMarkers(Map& map);
     void FindTileMarkers(Map& map);
     void FindObjectMarkers(Map& map);
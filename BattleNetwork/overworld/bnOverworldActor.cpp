@@ -186,7 +186,10 @@ void Overworld::Actor::Update(float elapsed, Map& map, SpatialMap& spatialMap)
     currTexture = texture;
   }
 
-  UpdateAnimationState(elapsed);
+  // culled actors are off screen, animation resumes once they are back in view
+  if (!IsCulled()) {
+    UpdateAnimationState(elapsed);
+  }
 
   if (state != MovementState::idle && moveThisFrame) {
     auto& [_, new_pos] = CanMoveTo(GetHeading(), state, elapsed, map, spatialMap);
@@ -454,29 +457,36 @@ const std::pair<bool, sf::Vector3f> Overworld::Actor::CanMoveTo(sf::Vector2f new
   * If we can move forward, check neighboring actors
   */
   if (solid) {
-    for (const auto& actor : spatialMap.GetNeighbors(*this)) {
-      if (actor.get() == this || !actor->solid) continue;
+    std::optional<sf::Vector3f> pushedOutPos;
 
-      auto elevationDifference = std::fabs(actor->GetElevation() - newPos3D.z);
+    spatialMap.ForEachNeighbor(*this, [&](Actor& actor) {
+      if (!actor.solid) return true;
 
-      if (elevationDifference > 0.1f) continue;
+      auto elevationDifference = std::fabs(actor.GetElevation() - newPos3D.z);
 
-      auto collision = CollidesWith(*actor, offset);
+      if (elevationDifference > 0.1f) return true;
 
-      if (collision) {
-        // push the ourselves out of the other actor
-        // use current position to prevent sliding off map
-        auto delta = currPos - actor->getPosition();
-        float distance = Hypotenuse(delta);
-        auto delta_unit = sf::Vector2f(delta.x / distance, delta.y / distance);
-        auto sumOfRadii = collisionRadius + actor->GetCollisionRadius();
-        auto outPos = actor->getPosition() + (delta_unit * sumOfRadii);
+      auto collision = CollidesWith(actor, offset);
 
-        auto outPosInTileSpace = map.WorldToTileSpace(outPos);
-        auto elevation = map.GetElevationAt(outPosInTileSpace.x, outPosInTileSpace.y, newLayer);
+      if (!collision) return true;
 
-        return { false, { outPos.x, outPos.y, elevation } };
-      }
+      // push the ourselves out of the other actor
+      // use current position to prevent sliding off map
+      auto delta = currPos - actor.getPosition();
+      float distance = Hypotenuse(delta);
+      auto delta_unit = sf::Vector2f(delta.x / distance, delta.y / distance);
+      auto sumOfRadii = collisionRadius + actor.GetCollisionRadius();
+      auto outPos = actor.getPosition() + (delta_unit * sumOfRadii);
+
+      auto outPosInTileSpace = map.WorldToTileSpace(outPos);
+      auto elevation = map.GetElevationAt(outPosInTileSpace.x, outPosInTileSpace.y, newLayer);
+
+      pushedOutPos = sf::Vector3f(outPos.x, outPos.y, elevation);
+      return false;
+    });
+
+    if (pushedOutPos) {
+      return { false, *pushedOutPos };
     }
   }
 
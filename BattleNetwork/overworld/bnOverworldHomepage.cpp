@@ -117,8 +117,7 @@ Overworld::Homepage::Homepage(swoosh::ActivityController& controller) :
       mrprog->Face(*with);
 
       // Play message
-      sf::Sprite face;
-      face.setTexture(*Textures().LoadFromFile("resources/ow/prog/prog_mug.png"));
+      std::shared_ptr<sf::Texture> face = Textures().LoadFromFile("resources/ow/prog/prog_mug.png");
 
       std::string message = "If you're seeing this message, something has gone horribly wrong with the next area.";
       message += "For your safety you cannot enter the next area!";
@@ -159,8 +158,7 @@ Overworld::Homepage::Homepage(swoosh::ActivityController& controller) :
       mrprog->Face(*with);
 
       // Play message
-      sf::Sprite face;
-      face.setTexture(*Textures().LoadFromFile("resources/ow/prog/prog_mug.png"));
+      std::shared_ptr<sf::Texture> face = Textures().LoadFromFile("resources/ow/prog/prog_mug.png");
 
       std::string message = "CHANGE YOUR WARP DESTINATION?";
 
@@ -332,7 +330,7 @@ void Overworld::Homepage::onUpdate(double elapsed)
     auto mugshot = Textures().LoadFromFile(image);
 
     auto& menuSystem = GetMenuSystem();
-    menuSystem.SetNextSpeaker(sf::Sprite(*mugshot), anim);
+    menuSystem.SetNextSpeaker(mugshot, anim);
     menuSystem.EnqueueMessage("This is your homepage.");
     menuSystem.EnqueueMessage("You can edit it anyway you like!");
 
@@ -428,14 +426,22 @@ void Overworld::Homepage::OnInteract(Interaction type) {
   auto targetPos = player->PositionInFrontOf();
   auto targetOffset = targetPos - player->getPosition();
 
-  for (const auto& other : GetSpatialMap().GetChunk(targetPos.x, targetPos.y)) {
-    if (player == other) continue;
+  Overworld::Actor* target = nullptr;
 
-    auto collision = player->CollidesWith(*other, targetOffset);
+  GetSpatialMap().ForEachInChunk(targetPos.x, targetPos.y, [&](Overworld::Actor& other) {
+    if (player.get() == &other) return true;
+
+    auto collision = player->CollidesWith(other, targetOffset);
 
     if (collision) {
-      other->Interact(player, type);
-      break;
+      target = &other;
+      return false;
     }
+
+    return true;
+  });
+
+  if (target) {
+    target->Interact(player, type);
   }
 }
@@ -28,9 +28,6 @@ namespace Overworld {
     for (int i = 0; i < layers.size(); i++) {
       auto& layer = layers[i];
 
-      tilesModified |= layer.tilesModified;
-      layer.tilesModified = false;
-
       for (auto& tileObject : layer.tileObjects) {
         tileObject.Update(*this);
       }
@@ -42,12 +39,42 @@ namespace Overworld {
       layer.spritesForAddition.clear();
     }
 
+    UpdateShadows();
+  }
+
+  void Map::UpdateShadows() {
+    for (auto& layer : layers) {
+      tilesModified |= layer.tilesModified;
+      layer.tilesModified = false;
+    }
+
     if (tilesModified) {
       shadowMap.CalculateShadows(*this);
       tilesModified = false;
     }
   }
 
+  void Map::ResolveTextures(const std::function<std::shared_ptr<sf::Texture>(const std::string&)>& getTexture) {
+    for (auto& [_, tileset] : tilesets) {
+      if (!tileset->texture) {
+        tileset->texture = getTexture(tileset->texturePath);
+      }
+    }
+
+    for (auto& tileMeta : tileMetas) {
+      if (!tileMeta) continue;
+
+      auto tileset = GetTileset(tileMeta->gid);
+
+      if (!tileset || !tileset->texture || tileMeta->sprite.getTexture() == tileset->texture.get()) {
+        continue;
+      }
+
+      tileMeta->sprite.setTexture(*tileset->texture);
+      tileMeta->animation.Refresh(tileMeta->sprite);
+    }
+  }
+
   sf::Vector2f Map::ScreenToWorld(sf::Vector2f screen) const {
     sf::Vector2f world{};
     world.x = (2.0f * screen.y + screen.x) * 0.5f;
@@ -82,6 +82,18 @@ namespace Overworld {
      */
     void Update(SceneBase& scene, double time);
 
+    /**
+     * @brief Recalculates the shadow map if tiles were modified since the last call
+     * Does not touch the scene, so maps loaded in the background can have their shadows ready before use
+     */
+    void UpdateShadows();
+
+    /**
+     * @brief Fetches tileset textures that were left unresolved while loading
+     * @param getTexture called once per tileset with the tileset's texture path
+     */
+    void ResolveTextures(const std::function<std::shared_ptr<sf::Texture>(const std::string&)>& getTexture);
+
     /**
      * @brief Transforms a point on the screen to in-world coordinates
      * @param screen vector from screen
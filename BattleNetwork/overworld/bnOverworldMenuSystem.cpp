@@ -82,7 +82,7 @@ namespace Overworld {
     bbsNeedsAck = false;
   }
 
-  void MenuSystem::SetNextSpeaker(const sf::Sprite& speaker, const Animation& animation) {
+  void MenuSystem::SetNextSpeaker(const std::shared_ptr<sf::Texture>& speaker, const Animation& animation) {
     textbox.SetNextSpeaker(speaker, animation);
   }
 
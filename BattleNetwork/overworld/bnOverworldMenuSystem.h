@@ -26,7 +26,7 @@ namespace Overworld {
     void ClearBBS();
     void AcknowledgeBBSSelection();
 
-    void SetNextSpeaker(const sf::Sprite& speaker, const Animation& animation);
+    void SetNextSpeaker(const std::shared_ptr<sf::Texture>& speaker, const Animation& animation);
     void EnqueueMessage(const std::string& message, const std::function<void()>& onComplete = []() {});
     void EnqueueQuestion(const std::string& prompt, const std::function<void(bool)>& onResponse);
     void EnqueueQuiz(
@@ -18,6 +18,7 @@
 #include "bnOverworldTileBehaviors.h"
 #include "bnOverworldObjectType.h"
 #include "bnOverworldPollingPacketProcessor.h"
+#include "bnOverworldTiledMapLoader.h"
 #include "../bnGameSession.h"
 #include "../bnMath.h"
 #include "../bnMobPackageManager.h"
@@ -39,6 +40,8 @@ constexpr float ROLLING_WINDOW_SMOOTHING = 3.0f;
 constexpr float SECONDS_PER_MOVEMENT = 1.f / 10.f;
 constexpr long long MAX_IDLE_MS = 1000;
 constexpr float MIN_IDLE_MOVEMENT = 1.f;
+constexpr float INTEREST_MARGIN = 64.f; // screen pixels around the camera where remote players are fully simulated
+constexpr double COARSE_UPDATE_SECONDS = 1.0 / 4.0; // update rate for remote players outside of the camera
 
 static long long GetSteadyTime() {
   return std::chrono::duration_cast<std::chrono::milliseconds>
@@ -154,7 +157,7 @@ void Overworld::OnlineArea::SetAvatarAsSpeaker() {
   const std::string& image = meta.GetMugshotTexturePath();
   const std::string& anim = meta.GetMugshotAnimationPath();
   std::shared_ptr<sf::Texture> mugshot = Textures().LoadFromFile(image);
-  GetMenuSystem().SetNextSpeaker(sf::Sprite(*mugshot), anim);
+  GetMenuSystem().SetNextSpeaker(mugshot, anim);
 }
 
 void Overworld::OnlineArea::onUpdate(double elapsed)
@@ -175,6 +178,8 @@ void Overworld::OnlineArea::onUpdate(double elapsed)
     return;
   }
 
+  updatePendingMap();
+
   if (!isConnected || kicked) {
     return;
   }
@@ -275,10 +280,24 @@ void Overworld::OnlineArea::updateOtherPlayers(double elapsed) {
     auto& onlinePlayer = pair.second;
     auto& actor = onlinePlayer.actor;
 
-    onlinePlayer.teleportController.Update(elapsed);
-    onlinePlayer.emoteNode->Update(elapsed);
+    // players far from the camera only receive a coarse position update at a reduced rate
+    bool inView = IsInView(actor->Get3DPosition(), INTEREST_MARGIN);
+    actor->SetCulled(!inView);
+
+    onlinePlayer.pendingElapsed += elapsed;
+    onlinePlayer.updatedThisFrame = inView || onlinePlayer.pendingElapsed >= COARSE_UPDATE_SECONDS;
+
+    if (!onlinePlayer.updatedThisFrame) {
+      continue;
+    }
+
+    double stepElapsed = onlinePlayer.pendingElapsed;
+    onlinePlayer.pendingElapsed = 0;
 
-    onlinePlayer.propertyAnimator.Update(*actor, elapsed);
+    onlinePlayer.teleportController.Update(stepElapsed);
+    onlinePlayer.emoteNode->Update(stepElapsed);
+
+    onlinePlayer.propertyAnimator.Update(*actor, stepElapsed);
 
     if (onlinePlayer.propertyAnimator.IsAnimatingPosition()) {
       continue;
@@ -298,6 +317,11 @@ void Overworld::OnlineArea::updateOtherPlayers(double elapsed) {
     auto newPos = RoundXY(onlinePlayer.startBroadcastPos + delta * alpha);
     actor->Set3DPosition(newPos);
 
+    if (!inView) {
+      // animation state is resolved once the player comes back into view
+      continue;
+    }
+
     if (onlinePlayer.propertyAnimator.IsAnimating() && actor->IsPlayingCustomAnimation()) {
       // skip animating the player if they're being animated by the property animator
       continue;
@@ -339,6 +363,11 @@ void Overworld::OnlineArea::updateOtherPlayers(double elapsed) {
   // update minimap markers
   for (auto& pair : onlinePlayers) {
     auto& onlinePlayer = pair.second;
+
+    if (!onlinePlayer.updatedThisFrame) {
+      continue;
+    }
+
     auto pos = onlinePlayer.actor->Get3DPosition();
 
     minimap.UpdatePlayerMarker(
@@ -687,21 +716,30 @@ void Overworld::OnlineArea::OnInteract(Interaction type) {
   auto positionInFrontOffset = frontPosition - playerActor->getPosition();
   auto elevation = playerActor->GetElevation();
 
-  for (const auto& other : GetSpatialMap().GetChunk(frontPosition.x, frontPosition.y)) {
-    if (playerActor == other) continue;
+  Overworld::Actor* target = nullptr;
 
-    auto elevationDifference = std::fabs(other->GetElevation() - elevation);
+  GetSpatialMap().ForEachInChunk(frontPosition.x, frontPosition.y, [&](Overworld::Actor& other) {
+    if (playerActor.get() == &other) return true;
 
-    if (elevationDifference >= 1.0f) continue;
+    auto elevationDifference = std::fabs(other.GetElevation() - elevation);
 
-    auto collision = playerActor->CollidesWith(*other, positionInFrontOffset);
+    if (elevationDifference >= 1.0f) return true;
 
-    if (collision) {
-      other->Interact(playerActor, type);
+    auto collision = playerActor->CollidesWith(other, positionInFrontOffset);
 
-      // block other interactions with return
-      return;
+    if (collision) {
+      target = &other;
+      return false;
     }
+
+    return true;
+  });
+
+  if (target) {
+    target->Interact(playerActor, type);
+
+    // block other interactions with return
+    return;
   }
 
   sendTileInteractionSignal(
@@ -810,6 +848,12 @@ void Overworld::OnlineArea::transferServer(const std::string& host, uint16_t por
 
 void Overworld::OnlineArea::processPacketBody(const Poco::Buffer<char>& data)
 {
+  if (pendingMap.valid()) {
+    // every packet after a map signal expects the new map to be loaded
+    deferredPackets.push(data);
+    return;
+  }
+
   BufferReader reader;
 
   try {
@@ -1639,7 +1683,36 @@ void Overworld::OnlineArea::receiveMapSignal(BufferReader& reader, const Poco::B
   auto path = reader.ReadString<uint16_t>(buffer);
   auto mapBuffer = GetText(path);
 
-  LoadMap(mapBuffer);
+  // asset lookups stay on this thread, parsing and shadows are computed on a worker
+  std::unordered_map<std::string, std::string> tilesets;
+
+  for (auto& tilesetPath : FindTiledMapTilesets(mapBuffer)) {
+    tilesets.emplace(tilesetPath, GetText(tilesetPath));
+  }
+
+  pendingMap = std::async(std::launch::async, [mapBuffer = std::move(mapBuffer), tilesets = std::move(tilesets)] {
+    return ParseTiledMap(mapBuffer, [&tilesets](const std::string& path) {
+      auto it = tilesets.find(path);
+      return it == tilesets.end() ? std::string() : it->second;
+    });
+  });
+}
+
+void Overworld::OnlineArea::updatePendingMap()
+{
+  if (!pendingMap.valid() || pendingMap.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+
+  auto optionalMap = pendingMap.get();
+
+  if (optionalMap) {
+    optionalMap->ResolveTextures([this](const std::string& path) { return GetTexture(path); });
+    LoadMap(std::move(optionalMap.value()));
+  }
+  else {
+    Logger::Log(LogLevel::critical, "Failed to load map");
+  }
 
   auto& map = GetMap();
   auto layerCount = map.GetLayerCount();
@@ -1681,6 +1754,12 @@ void Overworld::OnlineArea::receiveMapSignal(BufferReader& reader, const Poco::B
       }
     }
   }
+
+  // replay packets in order, stopping if one of them starts loading another map
+  while (!deferredPackets.empty() && !pendingMap.valid()) {
+    processPacketBody(deferredPackets.front());
+    deferredPackets.pop();
+  }
 }
 
 void Overworld::OnlineArea::receiveHealthSignal(BufferReader& reader, const Poco::Buffer<char>& buffer)
@@ -1962,8 +2041,7 @@ void Overworld::OnlineArea::receiveMessageSignal(BufferReader& reader, const Poc
   auto mugTexturePath = reader.ReadString<uint16_t>(buffer);
   auto mugAnimationPath = reader.ReadString<uint16_t>(buffer);
 
-  sf::Sprite face;
-  face.setTexture(*GetTexture(mugTexturePath));
+  std::shared_ptr<sf::Texture> face = GetTexture(mugTexturePath);
 
   Animation animation;
   animation.LoadWithData(GetText(mugAnimationPath));
@@ -1981,8 +2059,7 @@ void Overworld::OnlineArea::receiveQuestionSignal(BufferReader& reader, const Po
   auto mugTexturePath = reader.ReadString<uint16_t>(buffer);
   auto mugAnimationPath = reader.ReadString<uint16_t>(buffer);
 
-  sf::Sprite face;
-  face.setTexture(*GetTexture(mugTexturePath));
+  std::shared_ptr<sf::Texture> face = GetTexture(mugTexturePath);
 
   Animation animation;
   animation.LoadWithData(GetText(mugAnimationPath));
@@ -2002,8 +2079,7 @@ void Overworld::OnlineArea::receiveQuizSignal(BufferReader& reader, const Poco::
   auto mugTexturePath = reader.ReadString<uint16_t>(buffer);
   auto mugAnimationPath = reader.ReadString<uint16_t>(buffer);
 
-  sf::Sprite face;
-  face.setTexture(*GetTexture(mugTexturePath));
+  std::shared_ptr<sf::Texture> face = GetTexture(mugTexturePath);
   Animation animation;
 
   animation.LoadWithData(GetText(mugAnimationPath));
@@ -2348,7 +2424,7 @@ void Overworld::OnlineArea::receivePVPSignal(BufferReader& reader, const Poco::B
 
     NetworkBattleSceneProps props = {
       { player, GetProgramAdvance(), std::move(folder), std::make_shared<Field>(6, 3), GetBackground() },
-      sf::Sprite(*mugshot),
+      mugshot,
       mugshotAnim,
       emotions,
       netBattleProcessor,
@@ -2428,21 +2504,17 @@ void Overworld::OnlineArea::receiveModWhitelistSignal(BufferReader& reader, cons
       lineView = lineView.substr(0, lineView.size() - 1);
     }
 
-    if (lineView.size() <= 32) {
-      // not enough for md5 + package id
-      continue;
-    }
-
     size_t spaceIndex = lineView.find(' ');
     
-    if (spaceIndex == string::npos) {
-      // missing space
+    if (spaceIndex == string::npos || spaceIndex == 0 || spaceIndex + 1 >= lineView.size()) {
+      // missing hash, space, or package id
       continue;
     }
 
+    // hashes are not always md5 sized, see PackageFingerprint
     PackageHash packageHash;
-    packageHash.md5 = lineView.substr(0, 32);
-    packageHash.packageId = lineView.substr(33);
+    packageHash.md5 = lineView.substr(0, spaceIndex);
+    packageHash.packageId = lineView.substr(spaceIndex + 1);
 
     packageHashes.push_back(packageHash);
   } while(endLine < whitelistView.size());
@@ -2547,7 +2619,7 @@ void Overworld::OnlineArea::receiveMobSignal(BufferReader& reader, const Poco::B
         { player, GetProgramAdvance(), std::move(folder), mob->GetField(), mob->GetBackground() },
         { mob },
         mob->GetTurnLimit(),
-        sf::Sprite(*mugshot),
+        mugshot,
         mugshotAnim,
         emotions,
         localNaviBlocks
@@ -2561,7 +2633,7 @@ void Overworld::OnlineArea::receiveMobSignal(BufferReader& reader, const Poco::B
         { player, GetProgramAdvance(), std::move(folder), mob->GetField(), mob->GetBackground() },
         MobBattleProperties::RewardBehavior::take,
         { mob },
-        sf::Sprite(*mugshot),
+        mugshot,
         mugshotAnim,
         emotions,
         localNaviBlocks
@@ -5,6 +5,8 @@
 #include <map>
 #include <unordered_map>
 #include <functional>
+#include <future>
+#include <queue>
 
 #include "../bnBattleResults.h"
 #include "../bnVendorScene.h"
@@ -32,6 +34,8 @@ namespace Overworld {
     sf::Vector3f endBroadcastPos{};
     long long timestamp{};
     long long lastMovementTime{};
+    double pendingElapsed{}; //!< time accumulated while skipped by interest management
+    bool updatedThisFrame{ true };
     ActorPropertyAnimator propertyAnimator;
     RollingWindow<float, 40> lagWindow;
   };
@@ -109,6 +113,8 @@ namespace Overworld {
     CameraController warpCameraController;
     std::vector<VendorScene::Item> shopItems;
     std::queue<std::function<void()>> sceneChangeTasks;
+    std::future<std::optional<Map>> pendingMap; /*!< map being parsed on a worker thread */
+    std::queue<Poco::Buffer<char>> deferredPackets; /*!< received while a map is loading, replayed in order once it's swapped in */
 
     void ResetPVPStep(bool failed = false);
     void RemovePackages();
@@ -124,6 +130,7 @@ namespace Overworld {
     Overworld::TeleportController::Command& teleportIn(sf::Vector3f position, Direction direction);
     void transferServer(const std::string& host, uint16_t port, std::string data, bool warpOut);
     void processPacketBody(const Poco::Buffer<char>& data);
+    void updatePendingMap();
     void CheckPlayerAgainstWhitelist();
 
     void sendAssetFoundSignal(const std::string& path, uint64_t lastModified);
@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <algorithm>
 
 #include "bnOverworldSceneBase.h"
 #include "bnOverworldTiledMapLoader.h"
@@ -150,7 +151,7 @@ void Overworld::SceneBase::onUpdate(double elapsed) {
   // animations
   animElapsed += elapsed;
 
-  // expecting glitches, manually update when actors move?
+  // moves actors that crossed a cell boundary since last frame
   spatialMap.Update();
 
   // update tile animations
@@ -181,40 +182,7 @@ void Overworld::SceneBase::onUpdate(double elapsed) {
     return; // keep the screen looking the same when we come back
 #endif
 
-  auto layerCount = map.GetLayerCount() + 1;
-
-  if (spriteLayers.size() != layerCount) {
-    spriteLayers.resize(layerCount);
-  }
-
-  for (auto i = 0; i < layerCount; i++) {
-    auto& spriteLayer = spriteLayers[i];
-    auto elevation = (float)i;
-    bool isTopLayer = elevation + 1 == layerCount;
-    bool isBottomLayer = elevation == 0;
-
-    spriteLayer.clear();
-
-    // match sprites to layer
-    for (auto& sprite : sprites) {
-      // use ceil(elevation) + 1 instead of GetLayer to prevent sorting issues with stairs
-      auto spriteElevation = std::ceil(sprite->GetElevation()) + 1;
-      if (spriteElevation == elevation || (isTopLayer && spriteElevation >= layerCount) || (isBottomLayer && spriteElevation < 0)) {
-        spriteLayer.push_back(sprite);
-      }
-    }
-
-    // sort sprites within the layer
-    std::sort(spriteLayer.begin(), spriteLayer.end(),
-      [](const std::shared_ptr<WorldSprite>& A, const std::shared_ptr<WorldSprite>& B) {
-      auto& A_pos = A->getPosition();
-      auto& B_pos = B->getPosition();
-      auto A_compare = A_pos.x + A_pos.y;
-      auto B_compare = B_pos.x + B_pos.y;
-
-      return A_compare < B_compare;
-    });
-  }
+  UpdateSpriteLayers();
 
   // grabbing the camera pos for parallax
   const sf::Vector2f& cameraPos = camera.GetView().getCenter();
@@ -241,6 +209,78 @@ void Overworld::SceneBase::onUpdate(double elapsed) {
   }
 }
 
+void Overworld::SceneBase::UpdateSpriteLayers() {
+  int layerCount = (int)map.GetLayerCount() + 1;
+
+  if ((int)spriteLayers.size() != layerCount) {
+    // layer boundaries changed, every sprite needs to be placed again
+    for (auto& spriteLayer : spriteLayers) {
+      for (auto& sprite : spriteLayer) {
+        sprite->SetSortLayer(-1);
+      }
+
+      spriteLayer.clear();
+    }
+
+    spriteLayers.resize(layerCount);
+  }
+
+  // move sprites that changed layers to the back of their new layer
+  for (auto& sprite : sprites) {
+    int layer = -1;
+
+    if (!sprite->IsCulled()) {
+      // use ceil(elevation) + 1 instead of GetLayer to prevent sorting issues with stairs
+      auto spriteElevation = std::ceil(sprite->GetElevation()) + 1;
+      layer = std::clamp((int)spriteElevation, 0, layerCount - 1);
+    }
+
+    if (layer == sprite->GetSortLayer()) {
+      continue;
+    }
+
+    sprite->SetSortLayer(layer);
+
+    if (layer >= 0) {
+      spriteLayers[layer].push_back(sprite);
+    }
+  }
+
+  auto sortKey = [](const std::shared_ptr<WorldSprite>& sprite) {
+    auto& pos = sprite->getPosition();
+    return pos.x + pos.y;
+  };
+
+  for (int i = 0; i < layerCount; i++) {
+    auto& spriteLayer = spriteLayers[i];
+
+    // drop sprites that left this layer, keeping last frame's order for the rest
+    spriteLayer.erase(std::remove_if(spriteLayer.begin(), spriteLayer.end(),
+      [i](const std::shared_ptr<WorldSprite>& sprite) {
+      return sprite->GetSortLayer() != i;
+    }), spriteLayer.end());
+
+    // layers are nearly sorted from last frame, insertion sort only pays for sprites that moved
+    for (size_t j = 1; j < spriteLayer.size(); j++) {
+      auto key = sortKey(spriteLayer[j]);
+
+      if (!(key < sortKey(spriteLayer[j - 1]))) {
+        continue;
+      }
+
+      auto sprite = std::move(spriteLayer[j]);
+      size_t k = j;
+
+      while (k > 0 && key < sortKey(spriteLayer[k - 1])) {
+        spriteLayer[k] = std::move(spriteLayer[k - 1]);
+        k--;
+      }
+
+      spriteLayer[k] = std::move(sprite);
+    }
+  }
+}
+
 void Overworld::SceneBase::HandleCamera(float elapsed) {
   if (!cameraLocked) {
     // Follow the navi
@@ -679,8 +719,11 @@ void Overworld::SceneBase::LoadMap(const std::string& data)
     return;
   }
 
-  auto map = std::move(optionalMap.value());
+  LoadMap(std::move(optionalMap.value()));
+}
 
+void Overworld::SceneBase::LoadMap(Map map)
+{
   bool backgroundDiffers = map.GetBackgroundName() != this->map.GetBackgroundName() ||
     map.GetBackgroundCustomTexturePath() != this->map.GetBackgroundCustomTexturePath() ||
     map.GetBackgroundCustomAnimationPath() != this->map.GetBackgroundCustomAnimationPath() ||
@@ -752,6 +795,18 @@ void Overworld::SceneBase::RemoveSprite(const std::shared_ptr<WorldSprite>& spri
 
   if (pos != sprites.end())
     sprites.erase(pos);
+
+  int layer = sprite->GetSortLayer();
+
+  if (layer >= 0 && layer < (int)spriteLayers.size()) {
+    auto& spriteLayer = spriteLayers[layer];
+    auto layerPos = std::find(spriteLayer.begin(), spriteLayer.end(), sprite);
+
+    if (layerPos != spriteLayer.end())
+      spriteLayer.erase(layerPos);
+  }
+
+  sprite->SetSortLayer(-1);
 }
 
 void Overworld::SceneBase::AddActor(const std::shared_ptr<Actor>& actor) {
@@ -1008,6 +1063,21 @@ std::pair<unsigned, unsigned> Overworld::SceneBase::PixelToRowCol(const sf::Vect
   return { y, x };
 }
 
+bool Overworld::SceneBase::IsInView(const sf::Vector3f& worldPos, float margin) const
+{
+  const sf::View& view = camera.GetView();
+  auto& scale = worldTransform.getScale();
+
+  // the camera view is in unscaled screen space, the world is drawn scaled
+  auto halfSize = sf::Vector2f(view.getSize().x / scale.x, view.getSize().y / scale.y) * 0.5f;
+  halfSize.x += margin;
+  halfSize.y += margin;
+
+  auto delta = map.WorldToScreen(worldPos) - view.getCenter();
+
+  return std::fabs(delta.x) <= halfSize.x && std::fabs(delta.y) <= halfSize.y;
+}
+
 const bool Overworld::SceneBase::IsMouseHovering(const sf::Vector2f& mouse, const WorldSprite& src)
 {
   auto textureRect = src.getSprite().getTextureRect();
@@ -72,7 +72,7 @@ namespace Overworld {
     float foregroundParallaxFactor{ 0 };
     Overworld::Map map; /*!< Overworld map */
     std::vector<std::shared_ptr<WorldSprite>> sprites;
-    std::vector<std::vector<std::shared_ptr<WorldSprite>>> spriteLayers;
+    std::vector<std::vector<std::shared_ptr<WorldSprite>>> spriteLayers; /*!< kept sorted between frames */
     Overworld::MenuSystem menuSystem;
 
     /*!< Current player package selection */
@@ -83,6 +83,7 @@ namespace Overworld {
 
     void HandleCamera(float elapsed);
     void HandleInput();
+    void UpdateSpriteLayers();
     void LoadBackground(const Map& map, const std::string& value);
     void LoadForeground(const Map& map);
     void DrawWorld(sf::RenderTarget& target, sf::RenderStates states);
@@ -164,6 +165,11 @@ namespace Overworld {
     */
     void LoadMap(const std::string& data);
 
+    /**
+    * @brief Swaps in an already parsed map, textures must be resolved
+    */
+    void LoadMap(Map map);
+
     void TeleportUponReturn(const sf::Vector3f& position);
     const bool HasTeleportedAway() const;
 
@@ -268,6 +274,12 @@ namespace Overworld {
     //
     std::pair<unsigned, unsigned> PixelToRowCol(const sf::Vector2i& px, const sf::RenderWindow& window) const;
 
+    /**
+    * @brief Tests if a world position lands inside the camera's view
+    * @param margin extra screen space in pixels around the view that still counts as visible
+    */
+    bool IsInView(const sf::Vector3f& worldPos, float margin) const;
+
     //
     // Required implementations
     //
@@ -1,7 +1,6 @@
 #include "bnOverworldSpatialMap.h"
 
 #include <algorithm>
-#include <functional> 
 
 namespace Overworld {
   SpatialMap::SpatialMap() {
@@ -11,105 +10,125 @@ namespace Overworld {
   }
 
   void SpatialMap::AddActor(const std::shared_ptr<Actor>& actor) {
-    actors.insert(actor);
-  }
-
-  void SpatialMap::RemoveActor(const std::shared_ptr<Actor>& actor) {
-    auto iterEnd = actors.end();
-    auto iter = find(actors.begin(), iterEnd, actor);
+    auto [iter, inserted] = entries.try_emplace(actor.get());
 
-    if (iter != iterEnd) {
-      actors.erase(iter);
+    if (!inserted) {
+      return;
     }
-  }
 
-  static size_t GetHash(size_t x, size_t y) {
-    return (y << (sizeof(size_t) / 2)) + x;
+    Entry& entry = iter->second;
+    entry.actor = actor;
+    entry.cells = GetCellRange(*actor);
+    InsertEntry(entry);
   }
 
-  std::vector<std::shared_ptr<Actor>> SpatialMap::GetChunk(float x, float y) {
-    auto chunkHash = GetHash((size_t)(x / chunkLength), (size_t)(y / chunkLength));
-
-    auto it = chunks.find(chunkHash);
+  void SpatialMap::RemoveActor(const std::shared_ptr<Actor>& actor) {
+    auto iter = entries.find(actor.get());
 
-    if (it == chunks.end()) {
-      return {};
+    if (iter == entries.end()) {
+      return;
     }
 
-    return it->second;
-
+    EraseEntry(iter->second);
+    entries.erase(iter);
   }
 
-  // using template for handling differing const requirements
-  static void ForEachOverlappingChunk(
-    float chunkLength,
-    Actor& actor,
-    const std::function<void(size_t)>& callback
-  ) {
+  SpatialMap::CellRange SpatialMap::GetCellRange(Actor& actor) const {
     auto pos = actor.getPosition();
     auto radius = actor.GetCollisionRadius() / chunkLength;
     auto x = pos.x / chunkLength;
     auto y = pos.y / chunkLength;
 
-    int startX = static_cast<int>(x - radius);
-    int startY = static_cast<int>(y - radius);
-    int endX = static_cast<int>(x + radius + 1);
-    int endY = static_cast<int>(y + radius + 1);
+    CellRange range;
+    range.startX = static_cast<int>(std::floor(x - radius));
+    range.startY = static_cast<int>(std::floor(y - radius));
+    range.endX = static_cast<int>(std::floor(x + radius)) + 1;
+    range.endY = static_cast<int>(std::floor(y + radius)) + 1;
 
-    for (int i = startX; i < endX; i++) {
-      for (int j = startY; j < endY; j++) {
-        callback(GetHash(i, j));
+    return range;
+  }
+
+  void SpatialMap::InsertEntry(Entry& entry) {
+    const CellRange& range = entry.cells;
+
+    for (int i = range.startX; i < range.endX; i++) {
+      for (int j = range.startY; j < range.endY; j++) {
+        cells[GetKey(i, j)].push_back(&entry);
       }
     }
-  };
 
-  std::unordered_set<std::shared_ptr<Actor>> SpatialMap::GetNeighbors(Actor& actor) {
-    std::unordered_set<std::shared_ptr<Actor>> neighbors;
-    auto actorPtr = &actor;
-    auto endIt = chunks.end();
+    entry.inserted = true;
+  }
 
-    ForEachOverlappingChunk(chunkLength, actor, [&](size_t chunkHash) mutable {
-      auto it = chunks.find(chunkHash);
+  void SpatialMap::EraseEntry(Entry& entry) {
+    if (!entry.inserted) {
+      return;
+    }
 
-      if (it == endIt) {
-        return;
-      }
+    const CellRange& range = entry.cells;
+    auto endIt = cells.end();
+
+    for (int i = range.startX; i < range.endX; i++) {
+      for (int j = range.startY; j < range.endY; j++) {
+        auto it = cells.find(GetKey(i, j));
+
+        if (it == endIt) {
+          continue;
+        }
+
+        auto& cell = it->second;
+        auto pos = std::find(cell.begin(), cell.end(), &entry);
 
-      auto& chunk = it->second;
+        if (pos != cell.end()) {
+          // order within a cell doesn't matter, swap and pop
+          *pos = cell.back();
+          cell.pop_back();
+        }
 
-      for (auto& other : chunk) {
-        if (actorPtr != other.get()) {
-          neighbors.emplace(other);
+        if (cell.empty()) {
+          cells.erase(it);
         }
       }
-    });
+    }
 
-    return neighbors;
+    entry.inserted = false;
   }
 
   void SpatialMap::Update() {
-    chunks.clear();
-
     auto oldChunkLength = chunkLength;
 
-    for (auto& actor : actors) {
-      auto collisionRadius = actor->GetCollisionRadius();
+    for (auto& [_, entry] : entries) {
+      auto collisionRadius = entry.actor->GetCollisionRadius();
 
       if (collisionRadius > chunkLength) {
         chunkLength = collisionRadius;
       }
+    }
 
-      ForEachOverlappingChunk(oldChunkLength, *actor, [&](size_t chunkHash) mutable {
-        auto it = chunks.find(chunkHash);
+    if (chunkLength != oldChunkLength) {
+      // every cell boundary moved, rebuild from scratch
+      cells.clear();
 
-        if (it != chunks.end()) {
-          auto& chunk = it->second;
-          chunk.push_back(actor);
-        }
-        else {
-          chunks.emplace(chunkHash, std::vector<std::shared_ptr<Actor>>({ actor }));
-        }
-      });
+      for (auto& [_, entry] : entries) {
+        entry.inserted = false;
+        entry.cells = GetCellRange(*entry.actor);
+        InsertEntry(entry);
+      }
+
+      return;
+    }
+
+    // only touch actors that crossed a cell boundary
+    for (auto& [_, entry] : entries) {
+      CellRange range = GetCellRange(*entry.actor);
+
+      if (range == entry.cells) {
+        continue;
+      }
+
+      EraseEntry(entry);
+      entry.cells = range;
+      InsertEntry(entry);
     }
   }
 }
@@ -2,14 +2,23 @@
 
 #include "bnOverworldActor.h"
 
+#include <cmath>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace Overworld {
   class Actor;
 
+  /**
+  * @class SpatialMap
+  * @brief Persistent uniform grid of actors used for collision and interaction queries
+  *
+  * Actors are only moved between cells when their bounds cross a cell boundary.
+  * Queries iterate cells in place and never allocate, callbacks return false to stop early.
+  * Do not add or remove actors from inside a query callback.
+  */
   class SpatialMap {
   public:
     SpatialMap();
@@ -17,14 +26,116 @@ namespace Overworld {
     // automatically handled by Overworld::SceneBase AddActor/RemoveActor
     void AddActor(const std::shared_ptr<Actor>& actor);
     void RemoveActor(const std::shared_ptr<Actor>& actor);
-    std::vector<std::shared_ptr<Actor>> GetChunk(float x, float y);
-    std::unordered_set<std::shared_ptr<Actor>> GetNeighbors(Actor& actor);
+
+    /**
+    * @brief Calls callback(Actor&) for every actor occupying the cell at world position x, y
+    * @param callback returns true to keep iterating, false to stop
+    */
+    template<typename Callback>
+    void ForEachInChunk(float x, float y, Callback&& callback);
+
+    /**
+    * @brief Calls callback(Actor&) once for every other actor sharing a cell with actor
+    * @param callback returns true to keep iterating, false to stop
+    */
+    template<typename Callback>
+    void ForEachNeighbor(Actor& actor, Callback&& callback);
 
     void Update();
 
   private:
-    std::unordered_set<std::shared_ptr<Actor>> actors;
+    struct CellRange {
+      int startX{}, startY{}, endX{}, endY{}; // end is exclusive
+
+      bool operator==(const CellRange& other) const {
+        return startX == other.startX && startY == other.startY && endX == other.endX && endY == other.endY;
+      }
+
+      bool operator!=(const CellRange& other) const {
+        return !(*this == other);
+      }
+    };
+
+    struct Entry {
+      std::shared_ptr<Actor> actor;
+      CellRange cells;
+      bool inserted{ false };
+      size_t queryStamp{}; //!< de-duplicates actors spanning multiple cells during a query
+    };
+
+    struct CellHash {
+      size_t operator()(uint64_t key) const {
+        // splitmix64 finalizer, spreads neighboring cells across buckets
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return static_cast<size_t>(key);
+      }
+    };
+
+    using Cell = std::vector<Entry*>;
+
+    static uint64_t GetKey(int x, int y);
+    CellRange GetCellRange(Actor& actor) const;
+    void InsertEntry(Entry& entry);
+    void EraseEntry(Entry& entry);
+
     float chunkLength;
-    std::unordered_map<size_t, std::vector<std::shared_ptr<Actor>>> chunks;
+    size_t queryStamp{};
+    std::unordered_map<Actor*, Entry> entries; // node based: Entry* stays valid
+    std::unordered_map<uint64_t, Cell, CellHash> cells;
   };
+
+  inline uint64_t SpatialMap::GetKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+  }
+
+  template<typename Callback>
+  void SpatialMap::ForEachInChunk(float x, float y, Callback&& callback) {
+    int cellX = static_cast<int>(std::floor(x / chunkLength));
+    int cellY = static_cast<int>(std::floor(y / chunkLength));
+
+    auto it = cells.find(GetKey(cellX, cellY));
+
+    if (it == cells.end()) {
+      return;
+    }
+
+    for (Entry* entry : it->second) {
+      if (!callback(*entry->actor)) {
+        return;
+      }
+    }
+  }
+
+  template<typename Callback>
+  void SpatialMap::ForEachNeighbor(Actor& actor, Callback&& callback) {
+    auto stamp = ++queryStamp;
+    auto endIt = cells.end();
+    CellRange range = GetCellRange(actor);
+
+    for (int i = range.startX; i < range.endX; i++) {
+      for (int j = range.startY; j < range.endY; j++) {
+        auto it = cells.find(GetKey(i, j));
+
+        if (it == endIt) {
+          continue;
+        }
+
+        for (Entry* entry : it->second) {
+          if (entry->queryStamp == stamp || entry->actor.get() == &actor) {
+            continue;
+          }
+
+          entry->queryStamp = stamp;
+
+          if (!callback(*entry->actor)) {
+            return;
+          }
+        }
+      }
+    }
+  }
 }
@@ -20,6 +20,22 @@ namespace Overworld {
     return { layerPosition.x, layerPosition.y, elevation };
   }
 
+  void WorldSprite::SetCulled(bool culled) {
+    this->culled = culled;
+  }
+
+  bool WorldSprite::IsCulled() const {
+    return culled;
+  }
+
+  void WorldSprite::SetSortLayer(int layer) {
+    sortLayer = layer;
+  }
+
+  int WorldSprite::GetSortLayer() const {
+    return sortLayer;
+  }
+
   void WorldSprite::draw(sf::RenderTarget& target, sf::RenderStates states) const {
     states.transform *= preTransform;
     SpriteProxyNode::draw(target, states);
@@ -16,9 +16,23 @@ namespace Overworld {
     void Set3DPosition(sf::Vector3f position);
     sf::Vector3f Get3DPosition() const;
 
+    /**
+    * @brief Culled sprites are far from the camera and are skipped during sorting and drawing
+    */
+    void SetCulled(bool culled);
+    bool IsCulled() const;
+
+    /**
+    * @brief Index of the sprite layer this sprite is sorted into, -1 if none. Maintained by SceneBase
+    */
+    void SetSortLayer(int layer);
+    int GetSortLayer() const;
+
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
   private:
     sf::Transform preTransform;
     float elevation{};
+    bool culled{ false };
+    int sortLayer{ -1 };
   };
 }
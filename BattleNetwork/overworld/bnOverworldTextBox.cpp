@@ -11,7 +11,7 @@ namespace Overworld {
       turboScroll = false;
   }
 
-  void TextBox::SetNextSpeaker(const sf::Sprite& speaker, const Animation& animation) {
+  void TextBox::SetNextSpeaker(const std::shared_ptr<sf::Texture>& speaker, const Animation& animation) {
     nextSpeaker = speaker;
     nextAnimation = animation;
   }
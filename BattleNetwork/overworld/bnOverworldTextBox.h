@@ -13,7 +13,7 @@ namespace Overworld {
   public:
     TextBox(sf::Vector2f pos);
 
-    void SetNextSpeaker(const sf::Sprite& speaker, const Animation& animation);
+    void SetNextSpeaker(const std::shared_ptr<sf::Texture>& speaker, const Animation& animation);
     void EnqueueMessage(const std::string& message, const std::function<void()>& onComplete = []() {});
     void EnqueueQuestion(const std::string& prompt, const std::function<void(bool)>& onResponse);
     void EnqueueQuiz(
@@ -35,7 +35,7 @@ namespace Overworld {
 
   private:
     AnimatedTextBox textbox;
-    sf::Sprite nextSpeaker;
+    std::shared_ptr<sf::Texture> nextSpeaker;
     Animation nextAnimation;
     std::queue<std::function<void(InputManager& input, sf::Vector2f mousePos)>> handlerQueue;
     bool turboScroll;
@@ -24,7 +24,10 @@ namespace Overworld {
     customProperties(customProperties),
     collisionShapes(std::move(collisionShapes))
   {
-    sprite.setTexture(*tileset.texture);
+    if (tileset.texture) {
+      sprite.setTexture(*tileset.texture);
+    }
+
     animation = tileset.animation;
     animation << to_string(id) << Animator::Mode::Loop;
     animation.Refresh(sprite);
@@ -24,7 +24,8 @@ namespace Overworld
     const sf::Vector2f alignmentOffset;
     const Projection orientation; // used for collisions
     const CustomProperties customProperties;
-    std::shared_ptr<sf::Texture> texture;
+    const std::string texturePath;
+    std::shared_ptr<sf::Texture> texture; //!< nullptr until resolved, see Map::ResolveTextures
     Animation animation;
   };
 
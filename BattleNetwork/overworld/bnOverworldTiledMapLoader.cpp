@@ -3,7 +3,21 @@
 #include "bnXML.h"
 
 namespace Overworld {
-  static std::shared_ptr<Tileset> ParseTileset(SceneBase& scene, const XMLElement& tilesetElement, unsigned int firstgid) {
+  static std::string ResolveTilesetPath(std::string source) {
+    if (source.find("/server", 0) != 0) {
+      // client path
+      // todo: hardcoded path oof, this will only be fine if all of our tiles are in this folder
+      size_t pos = source.rfind('/');
+
+      if (pos != std::string::npos) {
+        source = "resources/ow/tiles" + source.substr(pos);
+      }
+    }
+
+    return source;
+  }
+
+  static std::shared_ptr<Tileset> ParseTileset(const XMLElement& tilesetElement, unsigned int firstgid) {
     auto tileCount = static_cast<unsigned int>(tilesetElement.GetAttributeInt("tilecount"));
     auto tileWidth = tilesetElement.GetAttributeInt("tilewidth");
     auto tileHeight = tilesetElement.GetAttributeInt("tileheight");
@@ -137,7 +151,8 @@ namespace Overworld {
       sf::Vector2f(alignmentOffset),
       orientation,
       customProperties,
-      scene.GetTexture(texturePath),
+      texturePath,
+      nullptr, // resolved on the game thread, see Map::ResolveTextures
       animation
     };
 
@@ -209,7 +224,50 @@ namespace Overworld {
     return tileMetas;
   }
 
+  std::vector<std::string> FindTiledMapTilesets(const std::string& data)
+  {
+    std::vector<std::string> paths;
+    const std::string tag = "<tileset";
+    const std::string sourceAttribute = "source=\"";
+
+    for (size_t start = data.find(tag); start != std::string::npos; start = data.find(tag, start + tag.size())) {
+      size_t end = data.find('>', start);
+
+      if (end == std::string::npos) {
+        break;
+      }
+
+      size_t sourceStart = data.find(sourceAttribute, start);
+
+      if (sourceStart == std::string::npos || sourceStart > end) {
+        continue;
+      }
+
+      sourceStart += sourceAttribute.size();
+      size_t sourceEnd = data.find('"', sourceStart);
+
+      if (sourceEnd == std::string::npos || sourceEnd > end) {
+        continue;
+      }
+
+      paths.push_back(ResolveTilesetPath(data.substr(sourceStart, sourceEnd - sourceStart)));
+    }
+
+    return paths;
+  }
+
   std::optional<Map> LoadTiledMap(SceneBase& scene, const std::string& data)
+  {
+    auto map = ParseTiledMap(data, [&scene](const std::string& path) { return scene.GetText(path); });
+
+    if (map) {
+      map->ResolveTextures([&scene](const std::string& path) { return scene.GetTexture(path); });
+    }
+
+    return map;
+  }
+
+  std::optional<Map> ParseTiledMap(const std::string& data, const std::function<std::string(const std::string&)>& getText)
   {
     XMLElement mapElement = parseXML(data);
 
@@ -313,20 +371,10 @@ namespace Overworld {
     // load tilesets
     for (auto& mapTilesetElement : tilesetElements) {
       auto firstgid = static_cast<unsigned int>(mapTilesetElement.GetAttributeInt("firstgid"));
-      auto source = mapTilesetElement.GetAttribute("source");
+      auto source = ResolveTilesetPath(mapTilesetElement.GetAttribute("source"));
 
-      if (source.find("/server", 0) != 0) {
-        // client path
-        // todo: hardcoded path oof, this will only be fine if all of our tiles are in this folder
-        size_t pos = source.rfind('/');
-
-        if (pos != std::string::npos) {
-          source = "resources/ow/tiles" + source.substr(pos);
-        }
-      }
-
-      XMLElement tilesetElement = parseXML(scene.GetText(source));
-      auto tileset = ParseTileset(scene, tilesetElement, firstgid);
+      XMLElement tilesetElement = parseXML(getText(source));
+      auto tileset = ParseTileset(tilesetElement, firstgid);
       auto tileMetas = ParseTileMetas(tilesetElement, *tileset);
 
       for (auto& tileMeta : tileMetas) {
@@ -411,6 +459,8 @@ namespace Overworld {
       }
     }
 
+    map.UpdateShadows();
+
     return std::move(map);
   }
 }
\ No newline at end of file
@@ -2,8 +2,26 @@
 
 #include "bnOverworldMap.h"
 #include "bnOverworldSceneBase.h"
+#include <functional>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace Overworld {
+  /**
+  * @brief Parses a map and fetches its tilesets and textures through the scene
+  */
   std::optional<Map> LoadTiledMap(SceneBase& scene, const std::string& data);
+
+  /**
+  * @brief Parses a map without touching the scene or any resource manager, safe to run on a worker thread
+  * @param getText returns the contents of a tileset, called with paths listed by FindTiledMapTilesets
+  * Tileset textures are left unresolved, call Map::ResolveTextures on the game thread before use
+  */
+  std::optional<Map> ParseTiledMap(const std::string& data, const std::function<std::string(const std::string&)>& getText);
+
+  /**
+  * @brief Lists the resolved paths of every external tileset a map references, without parsing the whole map
+  */
+  std::vector<std::string> FindTiledMapTilesets(const std::string& data);
 }
@@ -2,9 +2,16 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 #include "result.h"
 #include "../stx/string.h"
 #include "../crypto/md5.h"
+#include "../crypto/xxhash64.h"
+
+// TODO: mac os < 10.5 file system support...
+#ifndef __APPLE__
+#include <filesystem>
+#endif
 
 /* STD LIBRARY extensions */
 namespace stx {
@@ -15,24 +22,106 @@ namespace stx {
   }
 
   static result_t<std::string> generate_md5_from_file(const std::string& path) {
-    std::vector<char> fileBuffer, md5Buffer;
-    md5Buffer.resize(16);
-    size_t len{};
-
-    std::ifstream fs(path, std::ios::binary | std::ios::ate);
+    std::ifstream fs(path, std::ios::binary);
 
     if (!fs.good()) {
       return error<std::string>("Unabled to read file " + path);
     }
 
-    std::ifstream::pos_type pos = fs.tellg();
-    len = pos;
-    fileBuffer.resize(len);
-    fs.seekg(0, std::ios::beg);
-    fs.read(&fileBuffer[0], pos);
+    // stream the file through so large zips do not need to fit in memory
+    struct xMD5Context context;
+    std::vector<char> chunk(64 * 1024);
+    unsigned char md5Buffer[16];
+
+    xMD5Init(&context);
+
+    while (fs.read(chunk.data(), chunk.size()) || fs.gcount() > 0) {
+      xMD5Update(&context, reinterpret_cast<const byte*>(chunk.data()), static_cast<size_t>(fs.gcount()));
+    }
+
+    if (fs.bad()) {
+      return error<std::string>("Unabled to read file " + path);
+    }
+
+    xMD5Final(md5Buffer, &context);
+
+    return ok(stx::as_hex(std::string(reinterpret_cast<char*>(md5Buffer), sizeof(md5Buffer)), 0));
+  }
+
+  /**
+  * @brief Hashes every file under a directory with XXH64 without copying or zipping it
+  *
+  * Files are visited in sorted relative path order. Each file contributes its relative path,
+  * its size and its contents, so the hash only depends on the directory contents and two
+  * directories with identical files hash the same on every machine.
+  */
+  static result_t<std::string> generate_xxh64_from_directory(const std::string& path) {
+#ifndef __APPLE__
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::path root(path);
+    std::vector<std::string> files;
+
+    if (!fs::is_directory(root, ec)) {
+      return error<std::string>("Not a directory " + path);
+    }
+
+    for (auto iter = fs::recursive_directory_iterator(root, ec); !ec && iter != fs::recursive_directory_iterator(); iter.increment(ec)) {
+      if (iter->is_regular_file(ec) && !ec) {
+        files.push_back(iter->path().lexically_relative(root).generic_string());
+      }
+    }
+
+    if (ec) {
+      return error<std::string>("Unabled to read directory " + path);
+    }
+
+    std::sort(files.begin(), files.end());
+
+    XXH64State state;
+    std::vector<char> chunk(64 * 1024);
+
+    XXH64Init(&state, 0);
+
+    for (const std::string& file : files) {
+      std::ifstream in(root / fs::path(file), std::ios::binary);
+
+      if (!in.good()) {
+        return error<std::string>("Unabled to read file " + file);
+      }
+
+      uint64_t size = static_cast<uint64_t>(fs::file_size(root / fs::path(file), ec));
+
+      if (ec) {
+        return error<std::string>("Unabled to read file " + file);
+      }
+
+      unsigned char sizeBytes[8];
+      for (int i = 0; i < 8; i++) sizeBytes[i] = static_cast<unsigned char>(size >> (i * 8));
+
+      // the terminator keeps "a" + "bc" and "ab" + "c" from hashing the same
+      XXH64Update(&state, file.c_str(), file.size() + 1);
+      XXH64Update(&state, sizeBytes, sizeof(sizeBytes));
+
+      while (in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+        XXH64Update(&state, chunk.data(), static_cast<size_t>(in.gcount()));
+      }
+
+      if (in.bad()) {
+        return error<std::string>("Unabled to read file " + file);
+      }
+    }
+
+    uint64_t hash = XXH64Digest(&state);
+    unsigned char hashBytes[8];
 
-    MD5(&md5Buffer[0], &fileBuffer[0], len);
+    // big endian so the hex reads the same as the number
+    for (int i = 0; i < 8; i++) hashBytes[i] = static_cast<unsigned char>(hash >> ((7 - i) * 8));
 
-    return ok(stx::as_hex(std::string(md5Buffer.data(), md5Buffer.size()), 0));
+    return ok(stx::as_hex(std::string(reinterpret_cast<char*>(hashBytes), sizeof(hashBytes)), 0));
+#else
+    return error<std::string>("System filedirectory utils not supported on APPLE");
+#endif
   }
 }
\ No newline at end of file